@@ -0,0 +1,207 @@
+// Packed proportional 5x7 font
+// Generated by tools/fontpack.py from Font_5x7_extended.h, do not edit.
+
+#define FONT_FIRST		32			// character code of the first glyph
+#define FONT_COUNT		144			// number of glyphs
+#define FONT_GROUP		8			// number of glyphs per entry of font_offset[]
+
+// offset of the first glyph of every group of FONT_GROUP glyphs in font_data[]
+const uint16_t font_offset[] PROGMEM = {
+	0, 29, 58, 89, 117, 150, 182, 217,
+	249, 279, 307, 339, 364, 400, 437, 473,
+	510, 550,
+};
+
+// offset of every glyph within its group in font_data[]
+const uint8_t font_start[] PROGMEM = {
+	0, 3, 4, 7, 12, 17, 22, 27, 0, 3, 6, 11, 16, 18, 22, 24,
+	0, 4, 7, 11, 15, 19, 23, 27, 0, 4, 8, 10, 12, 16, 20, 24,
+	0, 5, 9, 13, 17, 21, 25, 29, 0, 4, 7, 11, 15, 19, 24, 28,
+	0, 4, 8, 12, 16, 21, 25, 30, 0, 5, 10, 14, 17, 22, 25, 28,
+	0, 2, 6, 10, 14, 18, 22, 26, 0, 4, 5, 8, 12, 15, 20, 24,
+	0, 4, 8, 11, 15, 19, 23, 27, 0, 5, 9, 13, 16, 17, 20, 25,
+	0, 5, 10, 15, 20, 24, 28, 32, 0, 4, 8, 12, 17, 22, 27, 32,
+	0, 5, 10, 14, 18, 23, 26, 31, 0, 3, 7, 12, 17, 22, 27, 32,
+	0, 5, 10, 15, 20, 25, 30, 35, 0, 5, 9, 14, 19, 24, 29, 34,
+};
+
+// width of every glyph in columns (4 bits per glyph, low nibble = even glyph number)
+const uint8_t font_width[] PROGMEM = {
+	0x13, 0x53, 0x55, 0x25, 0x33, 0x55, 0x42, 0x52,
+	0x34, 0x44, 0x44, 0x44, 0x44, 0x22, 0x44, 0x44,
+	0x45, 0x44, 0x44, 0x44, 0x34, 0x44, 0x54, 0x44,
+	0x44, 0x44, 0x45, 0x55, 0x55, 0x34, 0x35, 0x43,
+	0x42, 0x44, 0x44, 0x44, 0x14, 0x43, 0x53, 0x44,
+	0x44, 0x43, 0x44, 0x54, 0x45, 0x34, 0x31, 0x05,
+	0x55, 0x55, 0x44, 0x44, 0x44, 0x54, 0x55, 0x55,
+	0x55, 0x44, 0x35, 0x55, 0x43, 0x55, 0x55, 0x55,
+	0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55,
+};
+
+// glyph number of every character code from FONT_FIRST to 255 (0xFF = no glyph)
+// Codes up to 191 select the glyph of the same number (special characters above 127),
+// Latin-1 letters from 192 are mapped to the umlaut glyphs or to their base letter.
+const uint8_t font_map[] PROGMEM = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,	// code 32
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,	// code 48
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,	// code 64
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,	// code 80
+	0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,	// code 96
+	0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,	// code 112
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,	// code 128
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,	// code 144
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,	// code 160
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,	// code 176
+	0x21, 0x21, 0x21, 0x21, 0x65, 0x21, 0xFF, 0x23, 0x25, 0x25, 0x25, 0x25, 0x29, 0x29, 0x29, 0x29,	// code 192
+	0xFF, 0x2E, 0x2F, 0x2F, 0x2F, 0x2F, 0x67, 0xFF, 0xFF, 0x35, 0x35, 0x35, 0x69, 0x39, 0xFF, 0x6A,	// code 208
+	0x41, 0x41, 0x41, 0x41, 0x64, 0x41, 0xFF, 0x43, 0x45, 0x45, 0x45, 0x45, 0x49, 0x49, 0x49, 0x49,	// code 224
+	0xFF, 0x4E, 0x4F, 0x4F, 0x4F, 0x4F, 0x66, 0xFF, 0xFF, 0x55, 0x55, 0x55, 0x68, 0x59, 0xFF, 0x59,	// code 240
+};
+
+// glyph columns
+const uint8_t font_data[] PROGMEM = {
+	0x00, 0x00, 0x00, 				//    (code 32)
+	0x5F, 							//  ! (code 33)
+	0x03, 0x00, 0x03, 				//  " (code 34)
+	0x14, 0x7F, 0x14, 0x7F, 0x14, 	//  # (code 35)
+	0x24, 0x2A, 0x7F, 0x2A, 0x12, 	//  $ (code 36)
+	0x23, 0x13, 0x08, 0x64, 0x62, 	//  % (code 37)
+	0x36, 0x49, 0x56, 0x20, 0x50, 	//  & (code 38)
+	0x05, 0x03, 					//  ' (code 39)
+	0x1C, 0x22, 0x41, 				//  ( (code 40)
+	0x41, 0x22, 0x1C, 				//  ) (code 41)
+	0x22, 0x14, 0x6B, 0x14, 0x22, 	//  * (code 42)
+	0x08, 0x08, 0x3E, 0x08, 0x08, 	//  + (code 43)
+	0x50, 0x30, 					//  , (code 44)
+	0x08, 0x08, 0x08, 0x08, 		//  - (code 45)
+	0x60, 0x60, 					//  . (code 46)
+	0x60, 0x10, 0x08, 0x04, 0x03, 	//  / (code 47)
+	0x3E, 0x41, 0x41, 0x3E, 		//  0 (code 48)
+	0x42, 0x7F, 0x40, 				//  1 (code 49)
+	0x62, 0x51, 0x49, 0x46, 		//  2 (code 50)
+	0x22, 0x41, 0x49, 0x36, 		//  3 (code 51)
+	0x18, 0x14, 0x12, 0x7F, 		//  4 (code 52)
+	0x27, 0x45, 0x45, 0x39, 		//  5 (code 53)
+	0x3C, 0x4A, 0x49, 0x31, 		//  6 (code 54)
+	0x01, 0x71, 0x0D, 0x03, 		//  7 (code 55)
+	0x36, 0x49, 0x49, 0x36, 		//  8 (code 56)
+	0x06, 0x49, 0x29, 0x1E, 		//  9 (code 57)
+	0x36, 0x36, 					//  : (code 58)
+	0x56, 0x36, 					//  ; (code 59)
+	0x08, 0x14, 0x22, 0x41, 		//  < (code 60)
+	0x14, 0x14, 0x14, 0x14, 		//  = (code 61)
+	0x41, 0x22, 0x14, 0x08, 		//  > (code 62)
+	0x02, 0x51, 0x09, 0x06, 		//  ? (code 63)
+	0x32, 0x49, 0x79, 0x41, 0x3E, 	//  @ (code 64)
+	0x7E, 0x09, 0x09, 0x7E, 		//  A (code 65)
+	0x7F, 0x49, 0x49, 0x36, 		//  B (code 66)
+	0x3E, 0x41, 0x41, 0x22, 		//  C (code 67)
+	0x7F, 0x41, 0x41, 0x3E, 		//  D (code 68)
+	0x7F, 0x49, 0x49, 0x41, 		//  E (code 69)
+	0x7F, 0x09, 0x09, 0x01, 		//  F (code 70)
+	0x3E, 0x49, 0x49, 0x3A, 		//  G (code 71)
+	0x7F, 0x08, 0x08, 0x7F, 		//  H (code 72)
+	0x41, 0x7F, 0x41, 				//  I (code 73)
+	0x20, 0x40, 0x40, 0x3F, 		//  J (code 74)
+	0x7F, 0x08, 0x14, 0x63, 		//  K (code 75)
+	0x7F, 0x40, 0x40, 0x40, 		//  L (code 76)
+	0x7F, 0x02, 0x0C, 0x02, 0x7F, 	//  M (code 77)
+	0x7F, 0x06, 0x18, 0x7F, 		//  N (code 78)
+	0x3E, 0x41, 0x41, 0x3E, 		//  O (code 79)
+	0x7F, 0x09, 0x09, 0x06, 		//  P (code 80)
+	0x3E, 0x41, 0x21, 0x5E, 		//  Q (code 81)
+	0x7F, 0x09, 0x19, 0x66, 		//  R (code 82)
+	0x26, 0x49, 0x49, 0x32, 		//  S (code 83)
+	0x01, 0x01, 0x7F, 0x01, 0x01, 	//  T (code 84)
+	0x3F, 0x40, 0x40, 0x3F, 		//  U (code 85)
+	0x07, 0x18, 0x60, 0x18, 0x07, 	//  V (code 86)
+	0x3F, 0x40, 0x38, 0x40, 0x3F, 	//  W (code 87)
+	0x63, 0x14, 0x08, 0x14, 0x63, 	//  X (code 88)
+	0x03, 0x04, 0x78, 0x04, 0x03, 	//  Y (code 89)
+	0x61, 0x59, 0x45, 0x43, 		//  Z (code 90)
+	0x7F, 0x41, 0x41, 				//  [ (code 91)
+	0x03, 0x04, 0x08, 0x10, 0x60, 	//  \ (code 92)
+	0x41, 0x41, 0x7F, 				//  ] (code 93)
+	0x02, 0x01, 0x02, 				//  ^ (code 94)
+	0x40, 0x40, 0x40, 0x40, 		//  _ (code 95)
+	0x03, 0x04, 					//  ` (code 96)
+	0x20, 0x54, 0x54, 0x78, 		//  a (code 97)
+	0x7F, 0x48, 0x48, 0x30, 		//  b (code 98)
+	0x38, 0x44, 0x44, 0x28, 		//  c (code 99)
+	0x38, 0x44, 0x44, 0x7F, 		//  d (code 100)
+	0x38, 0x54, 0x54, 0x48, 		//  e (code 101)
+	0x04, 0x7E, 0x05, 0x01, 		//  f (code 102)
+	0x48, 0x54, 0x54, 0x38, 		//  g (code 103)
+	0x7F, 0x08, 0x08, 0x70, 		//  h (code 104)
+	0x7A, 							//  i (code 105)
+	0x20, 0x40, 0x3A, 				//  j (code 106)
+	0x7F, 0x08, 0x14, 0x62, 		//  k (code 107)
+	0x41, 0x7F, 0x40, 				//  l (code 108)
+	0x7C, 0x04, 0x78, 0x04, 0x78, 	//  m (code 109)
+	0x7C, 0x04, 0x04, 0x78, 		//  n (code 110)
+	0x38, 0x44, 0x44, 0x38, 		//  o (code 111)
+	0x7C, 0x24, 0x24, 0x18, 		//  p (code 112)
+	0x18, 0x24, 0x24, 0x7C, 		//  q (code 113)
+	0x78, 0x04, 0x04, 				//  r (code 114)
+	0x48, 0x54, 0x54, 0x24, 		//  s (code 115)
+	0x04, 0x3F, 0x44, 0x44, 		//  t (code 116)
+	0x3C, 0x40, 0x40, 0x7C, 		//  u (code 117)
+	0x0C, 0x30, 0x40, 0x30, 		//  v (code 118)
+	0x3C, 0x40, 0x30, 0x40, 0x3C, 	//  w (code 119)
+	0x44, 0x28, 0x10, 0x28, 0x44, 	//  x (code 120)
+	0x4C, 0x50, 0x50, 0x3C, 		//  y (code 121)
+	0x64, 0x54, 0x4C, 0x44, 		//  z (code 122)
+	0x08, 0x36, 0x41, 				//  { (code 123)
+	0x7F, 							//  | (code 124)
+	0x41, 0x36, 0x08, 				//  } (code 125)
+	0x08, 0x04, 0x08, 0x10, 0x08, 	//  ~ (code 126)
+									//   (code 127)
+	0x1C, 0x2A, 0x49, 0x49, 0x22, 	//   (code 128)
+	0x1F, 0x04, 0x7F, 0x40, 0x40, 	//   (code 129)
+	0x20, 0x12, 0x10, 0x12, 0x20, 	//   (code 130)
+	0x10, 0x22, 0x20, 0x22, 0x10, 	//   (code 131)
+	0x21, 0x54, 0x54, 0x79, 		//   (code 132)
+	0x79, 0x14, 0x14, 0x79, 		//   (code 133)
+	0x39, 0x44, 0x44, 0x39, 		//   (code 134)
+	0x39, 0x44, 0x44, 0x39, 		//   (code 135)
+	0x3D, 0x40, 0x40, 0x7D, 		//   (code 136)
+	0x3D, 0x40, 0x40, 0x3D, 		//   (code 137)
+	0x7E, 0x25, 0x25, 0x1A, 		//   (code 138)
+	0x6C, 0x1A, 0x6F, 0x1A, 0x6C, 	//   (code 139)
+	0x7D, 0x5A, 0x1E, 0x5A, 0x7D, 	//   (code 140)
+	0x4E, 0x7B, 0x0F, 0x7B, 0x4E, 	//   (code 141)
+	0x7C, 0x3A, 0x7E, 0x3A, 0x7C, 	//   (code 142)
+	0x1C, 0x76, 0x2E, 0x76, 0x1C, 	//   (code 143)
+	0x1E, 0x34, 0x7C, 0x34, 0x1E, 	//   (code 144)
+	0x0C, 0x12, 0x24, 0x12, 0x0C, 	//   (code 145)
+	0x08, 0x1C, 0x3E, 0x7F, 		//   (code 146)
+	0x7F, 0x3E, 0x1C, 0x08, 		//   (code 147)
+	0x30, 0x3F, 0x01, 0x62, 0x7E, 	//   (code 148)
+	0x30, 0x3F, 0x02, 				//   (code 149)
+	0x1E, 0x3D, 0x77, 0x73, 0x31, 	//   (code 150)
+	0x60, 0x7E, 0x7B, 0x7E, 0x60, 	//   (code 151)
+	0x20, 0x5F, 0x23, 				//   (code 152)
+	0x7E, 0x7A, 0x7A, 0x7F, 		//   (code 153)
+	0x03, 0x45, 0x79, 0x45, 0x03, 	//   (code 154)
+	0x10, 0x28, 0x24, 0x28, 0x10, 	//   (code 155)
+	0x08, 0x14, 0x2A, 0x14, 0x08, 	//   (code 156)
+	0x00, 0x00, 0x00, 0x00, 0x00, 	//   (code 157)
+	0x36, 0x36, 0x08, 0x36, 0x36, 	//   (code 158)
+	0x1E, 0x14, 0x3C, 0x28, 0x78, 	//   (code 159)
+	0x44, 0x24, 0x1D, 0x24, 0x44, 	//    (code 160)
+	0x42, 0x24, 0x1D, 0x62, 0x01, 	//  ¡ (code 161)
+	0x08, 0x65, 0x1C, 0x22, 0x41, 	//  ¢ (code 162)
+	0x46, 0x24, 0x1D, 0x24, 0x4C, 	//  £ (code 163)
+	0x08, 0x44, 0x3D, 0x44, 0x08, 	//  ¤ (code 164)
+	0x4C, 0x24, 0x1D, 0x24, 0x46, 	//  ¥ (code 165)
+	0x01, 0x62, 0x1D, 0x62, 0x01, 	//  ¦ (code 166)
+	0x42, 0x24, 0x1D, 0x24, 0x42, 	//  § (code 167)
+	0x7C, 0x46, 0x57, 0x46, 0x7C, 	//  ¨ (code 168)
+	0x7F, 0x2A, 0x2A, 0x7F, 		//  © (code 169)
+	0x2A, 0x7F, 0x41, 0x7F, 0x2A, 	//  ª (code 170)
+	0x0A, 0x00, 0x55, 0x00, 0x0A, 	//  « (code 171)
+	0x30, 0x48, 0x4D, 0x33, 0x07, 	//  ¬ (code 172)
+	0x06, 0x29, 0x79, 0x29, 0x06, 	//  ­ (code 173)
+	0x08, 0x1C, 0x2A, 0x08, 0x08, 	//  ® (code 174)
+	0x08, 0x08, 0x2A, 0x1C, 0x08, 	//  ¯ (code 175)
+};
@@ -35,7 +35,23 @@ typedef uint8_t const* animation_t;
  * animation data *
  ******************/
 
-#define END_OF_DATA			0xFF
+// An animation is a sequence of frame records:
+//	raw frame:		DISP_COLUMNS bytes (one byte per column, bit 7 cleared)
+//	delta frame:	DELTA_FRAME(mask) followed by the new values of the columns whose bits
+//					are set in mask (bit 0 = column 1), the other columns are left unchanged
+//	repeat frame:	REPEAT_FRAME(n), the previous frame is shown n more times
+// Delta and repeat frames are generated by tools/animpack.py. As they depend on the
+// previous frame, the first frame and the first frame of the loop range are always
+// raw frames. Ping-pong playback (see StartAnimation() in main.c) works with all record
+// types, the player steps back by decoding the animation from its start (see PrevFrame()).
+// The following control codes may be put in front of a frame record. They are evaluated
+// by the animation player only (see PlayAnimation() in main.c), the scroller skips them.
+#define END_OF_DATA			0xFF			// end of animation
+#define LOOP_START			0xFE			// first frame of the loop range (default = first frame)
+#define FRAME_TIME(n)		(0x80 | (n))	// show the next frame n times as long as the others (range 1..63)
+#define IS_FRAME_TIME(ch)	(((ch) & 0xC0) == 0x80)
+#define DELTA_FRAME(mask)	(0xC0 | (mask))	// range 0x00..0x1F
+#define REPEAT_FRAME(n)		(0xE0 | (n))	// range 1..28
 
 #include "animations/arrow.h"
 #include "animations/fire.h"
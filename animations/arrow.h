@@ -1,18 +1,18 @@
 const unsigned char arrow[] PROGMEM = {
 	0x14, 0x2A, 0x49, 0x49, 0x3E, 	// frame 1
-	0x00, 0x1C, 0x2A, 0x49, 0x3E, 	// frame 2
+	DELTA_FRAME(0x07), 0x00, 0x1C, 0x2A, 	// frame 2
 	0x00, 0x3E, 0x49, 0x3E, 0x08, 	// frame 3
 	0x7F, 0x2A, 0x1C, 0x08, 0x08, 	// frame 4
-	0x22, 0x1C, 0x08, 0x08, 0x08, 	// frame 5
-	0x1C, 0x00, 0x08, 0x08, 0x08, 	// frame 6
-	0x00, 0x08, 0x08, 0x08, 0x08, 	// frame 7
-	0x08, 0x08, 0x08, 0x08, 0x00, 	// frame 8
-	0x08, 0x08, 0x08, 0x00, 0x00, 	// frame 9
-	0x08, 0x08, 0x00, 0x00, 0x00, 	// frame 10
-	0x08, 0x00, 0x00, 0x00, 0x00, 	// frame 11
-	0x00, 0x00, 0x00, 0x00, 0x0C, 	// frame 12
-	0x00, 0x00, 0x00, 0x0C, 0x12, 	// frame 13
-	0x00, 0x00, 0x0C, 0x12, 0x24, 	// frame 14
+	DELTA_FRAME(0x07), 0x22, 0x1C, 0x08, 	// frame 5
+	DELTA_FRAME(0x03), 0x1C, 0x00, 	// frame 6
+	DELTA_FRAME(0x03), 0x00, 0x08, 	// frame 7
+	DELTA_FRAME(0x11), 0x08, 0x00, 	// frame 8
+	DELTA_FRAME(0x08), 0x00, 		// frame 9
+	DELTA_FRAME(0x04), 0x00, 		// frame 10
+	DELTA_FRAME(0x02), 0x00, 		// frame 11
+	DELTA_FRAME(0x11), 0x00, 0x0C, 	// frame 12
+	DELTA_FRAME(0x18), 0x0C, 0x12, 	// frame 13
+	DELTA_FRAME(0x1C), 0x0C, 0x12, 0x24, 	// frame 14
 	0x00, 0x0C, 0x12, 0x24, 0x12, 	// frame 15
 	0x0C, 0x12, 0x24, 0x12, 0x0C, 	// frame 16
 	END_OF_DATA
@@ -1,5 +1,5 @@
 const unsigned char batt[] PROGMEM = {
-	0x00, 0x7e, 0x43, 0x7e, 0x00, // frame 1
-	0x00, 0x00, 0x00, 0x00, 0x00, // frame 2
+	0x00, 0x7E, 0x43, 0x7E, 0x00, 	// frame 1
+	DELTA_FRAME(0x0E), 0x00, 0x00, 0x00, 	// frame 2
 	END_OF_DATA
 };
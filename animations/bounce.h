@@ -1,11 +1,11 @@
 const unsigned char bounce[] PROGMEM = {
 	0x01, 0x00, 0x00, 0x00, 0x00, 	// frame 1
-	0x02, 0x02, 0x01, 0x00, 0x00, 	// frame 2
+	DELTA_FRAME(0x07), 0x02, 0x02, 0x01, 	// frame 2
 	0x06, 0x09, 0x09, 0x06, 0x00, 	// frame 3
 	0x00, 0x30, 0x48, 0x48, 0x30, 	// frame 4
 	0x00, 0x20, 0x50, 0x50, 0x20, 	// frame 5
 	0x00, 0x30, 0x48, 0x48, 0x30, 	// frame 6
 	0x00, 0x00, 0x06, 0x09, 0x09, 	// frame 7
-	0x00, 0x00, 0x00, 0x01, 0x02, 	// frame 8
+	DELTA_FRAME(0x1C), 0x00, 0x01, 0x02, 	// frame 8
 	END_OF_DATA
 };
@@ -1,11 +1,11 @@
 const unsigned char clock[] PROGMEM = {
 	0x1C, 0x22, 0x2E, 0x2A, 0x1C, 	// frame 1
-	0x1C, 0x22, 0x2A, 0x2E, 0x1C, 	// frame 2
-	0x1C, 0x22, 0x2A, 0x2A, 0x1C, 	// frame 3
-	0x1C, 0x22, 0x2A, 0x3A, 0x1C, 	// frame 4
-	0x1C, 0x22, 0x3A, 0x2A, 0x1C, 	// frame 5
-	0x1C, 0x32, 0x2A, 0x2A, 0x1C, 	// frame 6
-	0x1C, 0x2A, 0x2A, 0x2A, 0x1C, 	// frame 7
-	0x1C, 0x26, 0x2A, 0x2A, 0x1C, 	// frame 8
+	DELTA_FRAME(0x0C), 0x2A, 0x2E, 	// frame 2
+	DELTA_FRAME(0x08), 0x2A, 		// frame 3
+	DELTA_FRAME(0x08), 0x3A, 		// frame 4
+	DELTA_FRAME(0x0C), 0x3A, 0x2A, 	// frame 5
+	DELTA_FRAME(0x06), 0x32, 0x2A, 	// frame 6
+	DELTA_FRAME(0x02), 0x2A, 		// frame 7
+	DELTA_FRAME(0x02), 0x26, 		// frame 8
 	END_OF_DATA
 };
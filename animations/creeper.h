@@ -1,5 +1,5 @@
 const unsigned char creeper[] PROGMEM = {
-	0x00, 0x00, 0x06, 0x76, 0x38, // frame 1
-	0x38, 0x76, 0x06, 0x00, 0x00, // frame 2
+	0x00, 0x00, 0x06, 0x76, 0x38, 	// frame 1
+	0x38, 0x76, 0x06, 0x00, 0x00, 	// frame 2
 	END_OF_DATA
 };
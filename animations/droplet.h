@@ -1,13 +1,13 @@
 const unsigned char droplet[] PROGMEM = {
 	0x40, 0x40, 0x41, 0x40, 0x40, 	// frame 1
-	0x40, 0x40, 0x43, 0x40, 0x40, 	// frame 2
-	0x40, 0x40, 0x45, 0x40, 0x40, 	// frame 3
-	0x40, 0x40, 0x49, 0x40, 0x40, 	// frame 4
-	0x40, 0x40, 0x51, 0x40, 0x40, 	// frame 5
-	0x40, 0x40, 0x21, 0x40, 0x40, 	// frame 6
-	0x40, 0x40, 0x51, 0x40, 0x40, 	// frame 7
-	0x40, 0x48, 0x41, 0x48, 0x40, 	// frame 8
+	DELTA_FRAME(0x04), 0x43, 		// frame 2
+	DELTA_FRAME(0x04), 0x45, 		// frame 3
+	DELTA_FRAME(0x04), 0x49, 		// frame 4
+	DELTA_FRAME(0x04), 0x51, 		// frame 5
+	DELTA_FRAME(0x04), 0x21, 		// frame 6
+	DELTA_FRAME(0x04), 0x51, 		// frame 7
+	DELTA_FRAME(0x0E), 0x48, 0x41, 0x48, 	// frame 8
 	0x48, 0x40, 0x41, 0x40, 0x48, 	// frame 9
-	0x40, 0x40, 0x41, 0x40, 0x40, 	// frame 10
+	DELTA_FRAME(0x11), 0x40, 0x40, 	// frame 10
 	END_OF_DATA
 };
@@ -1,7 +1,7 @@
 const unsigned char ecg[] PROGMEM = {
 	0x10, 0x10, 0x10, 0x10, 0x10, 	// frame 1
-	0x08, 0x10, 0x10, 0x0F, 0x70, 	// frame 2
+	DELTA_FRAME(0x19), 0x08, 0x0F, 0x70, 	// frame 2
 	0x10, 0x10, 0x08, 0x08, 0x10, 	// frame 3
-	0x10, 0x10, 0x10, 0x10, 0x10, 	// frame 4
+	DELTA_FRAME(0x0C), 0x10, 0x10, 	// frame 4
 	END_OF_DATA
 };
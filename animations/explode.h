@@ -1,22 +1,21 @@
 const unsigned char explode[] PROGMEM = {
 	0x00, 0x02, 0x7D, 0x00, 0x00, 	// frame 1
-	0x00, 0x01, 0x7C, 0x02, 0x00, 	// frame 2
-	0x00, 0x00, 0x7A, 0x00, 0x00, 	// frame 3
-	0x00, 0x08, 0x72, 0x04, 0x00, 	// frame 4
-	0x00, 0x08, 0x60, 0x10, 0x00, 	// frame 5
-	0x00, 0x10, 0x68, 0x00, 0x00, 	// frame 6
-	0x00, 0x20, 0x40, 0x10, 0x00, 	// frame 7
-	0x00, 0x00, 0x20, 0x00, 0x00, 	// frame 8
-	0x00, 0x00, 0x00, 0x00, 0x00, 	// frame 9
-	0x00, 0x00, 0x00, 0x00, 0x00, 	// frame 10
-	0x00, 0x00, 0x00, 0x00, 0x00, 	// frame 11
-	0x00, 0x00, 0x30, 0x00, 0x00, 	// frame 12
-	0x00, 0x7C, 0x54, 0x38, 0x00, 	// frame 13
+	DELTA_FRAME(0x0E), 0x01, 0x7C, 0x02, 	// frame 2
+	DELTA_FRAME(0x0E), 0x00, 0x7A, 0x00, 	// frame 3
+	DELTA_FRAME(0x0E), 0x08, 0x72, 0x04, 	// frame 4
+	DELTA_FRAME(0x0C), 0x60, 0x10, 	// frame 5
+	DELTA_FRAME(0x0E), 0x10, 0x68, 0x00, 	// frame 6
+	DELTA_FRAME(0x0E), 0x20, 0x40, 0x10, 	// frame 7
+	DELTA_FRAME(0x0E), 0x00, 0x20, 0x00, 	// frame 8
+	DELTA_FRAME(0x04), 0x00, 		// frame 9
+	REPEAT_FRAME(2),				// frame 10..11
+	DELTA_FRAME(0x04), 0x30, 		// frame 12
+	DELTA_FRAME(0x0E), 0x7C, 0x54, 0x38, 	// frame 13
 	0x79, 0x3D, 0x24, 0x3D, 0x79, 	// frame 14
 	0x7B, 0x3F, 0x16, 0x3F, 0x7B, 	// frame 15
 	0x7E, 0x7C, 0x18, 0x7C, 0x7E, 	// frame 16
 	0x7C, 0x08, 0x10, 0x08, 0x7C, 	// frame 17
-	0x70, 0x08, 0x10, 0x08, 0x70, 	// frame 18
+	DELTA_FRAME(0x11), 0x70, 0x70, 	// frame 18
 	0x60, 0x08, 0x20, 0x10, 0x60, 	// frame 19
 	0x10, 0x40, 0x00, 0x20, 0x00, 	// frame 20
 	END_OF_DATA
@@ -15,9 +15,9 @@ const unsigned char fire[] PROGMEM = {
 	0x10, 0x68, 0x70, 0x34, 0x60, 	// frame 14
 	0x28, 0x4A, 0x60, 0x58, 0x60, 	// frame 15
 	0x60, 0x70, 0x38, 0x66, 0x18, 	// frame 16
-	0x60, 0x70, 0x78, 0x42, 0x19, 	// frame 17
+	DELTA_FRAME(0x1C), 0x78, 0x42, 0x19, 	// frame 17
 	0x58, 0x64, 0x70, 0x29, 0x70, 	// frame 18
 	0x70, 0x3A, 0x78, 0x54, 0x70, 	// frame 19
-	0x70, 0x51, 0x78, 0x6A, 0x70, 	// frame 20
+	DELTA_FRAME(0x0A), 0x51, 0x6A, 	// frame 20
 	END_OF_DATA
 };
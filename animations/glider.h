@@ -1,22 +1,22 @@
 const unsigned char glider[] PROGMEM = {
 	0x03, 0x00, 0x00, 0x00, 0x00, 	// frame 1
-	0x03, 0x00, 0x00, 0x00, 0x00, 	// frame 2
-	0x07, 0x00, 0x00, 0x00, 0x00, 	// frame 3
-	0x06, 0x02, 0x00, 0x00, 0x00, 	// frame 4
-	0x05, 0x06, 0x00, 0x00, 0x00, 	// frame 5
-	0x0C, 0x06, 0x00, 0x00, 0x00, 	// frame 6
-	0x08, 0x0E, 0x00, 0x00, 0x00, 	// frame 7
-	0x0A, 0x0C, 0x04, 0x00, 0x00, 	// frame 8
-	0x08, 0x0A, 0x0C, 0x00, 0x00, 	// frame 9
-	0x04, 0x18, 0x0C, 0x00, 0x00, 	// frame 10
-	0x08, 0x10, 0x1C, 0x00, 0x00, 	// frame 11
+	REPEAT_FRAME(1),				// frame 2
+	DELTA_FRAME(0x01), 0x07, 		// frame 3
+	DELTA_FRAME(0x03), 0x06, 0x02, 	// frame 4
+	DELTA_FRAME(0x03), 0x05, 0x06, 	// frame 5
+	DELTA_FRAME(0x01), 0x0C, 		// frame 6
+	DELTA_FRAME(0x03), 0x08, 0x0E, 	// frame 7
+	DELTA_FRAME(0x07), 0x0A, 0x0C, 0x04, 	// frame 8
+	DELTA_FRAME(0x07), 0x08, 0x0A, 0x0C, 	// frame 9
+	DELTA_FRAME(0x03), 0x04, 0x18, 	// frame 10
+	DELTA_FRAME(0x07), 0x08, 0x10, 0x1C, 	// frame 11
 	0x00, 0x14, 0x18, 0x08, 0x00, 	// frame 12
-	0x00, 0x10, 0x14, 0x18, 0x00, 	// frame 13
-	0x00, 0x08, 0x30, 0x18, 0x00, 	// frame 14
-	0x00, 0x10, 0x20, 0x38, 0x00, 	// frame 15
+	DELTA_FRAME(0x0E), 0x10, 0x14, 0x18, 	// frame 13
+	DELTA_FRAME(0x06), 0x08, 0x30, 	// frame 14
+	DELTA_FRAME(0x0E), 0x10, 0x20, 0x38, 	// frame 15
 	0x00, 0x00, 0x28, 0x30, 0x10, 	// frame 16
-	0x00, 0x00, 0x20, 0x28, 0x30, 	// frame 17
-	0x00, 0x00, 0x00, 0x00, 0x00, 	// frame 18
-	0x00, 0x00, 0x20, 0x28, 0x30, 	// frame 19
+	DELTA_FRAME(0x1C), 0x20, 0x28, 0x30, 	// frame 17
+	DELTA_FRAME(0x1C), 0x00, 0x00, 0x00, 	// frame 18
+	DELTA_FRAME(0x1C), 0x20, 0x28, 0x30, 	// frame 19
 	END_OF_DATA
 };
@@ -2,10 +2,10 @@ const unsigned char house[] PROGMEM = {
 	0x40, 0x40, 0x40, 0x40, 0x40, 	// frame 1
 	0x40, 0x60, 0x50, 0x48, 0x44, 	// frame 2
 	0x44, 0x64, 0x54, 0x4C, 0x44, 	// frame 3
-	0x44, 0x6C, 0x54, 0x6C, 0x44, 	// frame 4
-	0x44, 0x6C, 0x54, 0x6C, 0x7C, 	// frame 5
-	0x44, 0x6C, 0x55, 0x6E, 0x7C, 	// frame 6
-	0x44, 0x6E, 0x55, 0x6E, 0x7C, 	// frame 7
-	0x7C, 0x6E, 0x55, 0x6E, 0x7C, 	// frame 8
+	DELTA_FRAME(0x0A), 0x6C, 0x6C, 	// frame 4
+	DELTA_FRAME(0x10), 0x7C, 		// frame 5
+	DELTA_FRAME(0x0C), 0x55, 0x6E, 	// frame 6
+	DELTA_FRAME(0x02), 0x6E, 		// frame 7
+	DELTA_FRAME(0x01), 0x7C, 		// frame 8
 	END_OF_DATA
 };
@@ -2,22 +2,22 @@ const unsigned char pong[] PROGMEM = {
 	0x40, 0x40, 0x09, 0x01, 0x00, 	// frame 1
 	0x00, 0x45, 0x41, 0x00, 0x00, 	// frame 2
 	0x03, 0x01, 0x40, 0x40, 0x00, 	// frame 3
-	0x05, 0x01, 0x40, 0x40, 0x00, 	// frame 4
-	0x09, 0x41, 0x40, 0x00, 0x00, 	// frame 5
-	0x50, 0x41, 0x01, 0x00, 0x00, 	// frame 6
-	0x60, 0x41, 0x01, 0x00, 0x00, 	// frame 7
-	0x40, 0x51, 0x01, 0x00, 0x00, 	// frame 8
-	0x00, 0x41, 0x51, 0x00, 0x00, 	// frame 9
-	0x00, 0x00, 0x41, 0x49, 0x00, 	// frame 10
-	0x00, 0x00, 0x41, 0x41, 0x08, 	// frame 11
-	0x00, 0x00, 0x40, 0x45, 0x01, 	// frame 12
-	0x00, 0x00, 0x05, 0x41, 0x40, 	// frame 13
-	0x00, 0x03, 0x01, 0x40, 0x40, 	// frame 14
-	0x01, 0x05, 0x00, 0x40, 0x40, 	// frame 15
-	0x00, 0x09, 0x01, 0x40, 0x40, 	// frame 16
-	0x00, 0x10, 0x01, 0x41, 0x40, 	// frame 17
-	0x00, 0x20, 0x41, 0x41, 0x00, 	// frame 18
-	0x00, 0x40, 0x41, 0x41, 0x00, 	// frame 19
-	0x00, 0x40, 0x41, 0x01, 0x00, 	// frame 20
+	DELTA_FRAME(0x01), 0x05, 		// frame 4
+	DELTA_FRAME(0x0B), 0x09, 0x41, 0x00, 	// frame 5
+	DELTA_FRAME(0x05), 0x50, 0x01, 	// frame 6
+	DELTA_FRAME(0x01), 0x60, 		// frame 7
+	DELTA_FRAME(0x03), 0x40, 0x51, 	// frame 8
+	DELTA_FRAME(0x07), 0x00, 0x41, 0x51, 	// frame 9
+	DELTA_FRAME(0x0E), 0x00, 0x41, 0x49, 	// frame 10
+	DELTA_FRAME(0x18), 0x41, 0x08, 	// frame 11
+	DELTA_FRAME(0x1C), 0x40, 0x45, 0x01, 	// frame 12
+	DELTA_FRAME(0x1C), 0x05, 0x41, 0x40, 	// frame 13
+	DELTA_FRAME(0x0E), 0x03, 0x01, 0x40, 	// frame 14
+	DELTA_FRAME(0x07), 0x01, 0x05, 0x00, 	// frame 15
+	DELTA_FRAME(0x07), 0x00, 0x09, 0x01, 	// frame 16
+	DELTA_FRAME(0x0A), 0x10, 0x41, 	// frame 17
+	DELTA_FRAME(0x16), 0x20, 0x41, 0x00, 	// frame 18
+	DELTA_FRAME(0x02), 0x40, 		// frame 19
+	DELTA_FRAME(0x08), 0x01, 		// frame 20
 	END_OF_DATA
 };
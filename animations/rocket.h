@@ -1,10 +1,10 @@
 const unsigned char rocket[] PROGMEM = {
 	0x40, 0x3C, 0x43, 0x3C, 0x40, 	// frame 1
-	0x40, 0x7C, 0x43, 0x7C, 0x40, 	// frame 2
-	0x40, 0x3C, 0x43, 0x3C, 0x40, 	// frame 3
-	0x40, 0x7C, 0x43, 0x7C, 0x40, 	// frame 4
-	0x40, 0x3C, 0x43, 0x3C, 0x40, 	// frame 5
-	0x40, 0x7C, 0x43, 0x7C, 0x40, 	// frame 6
+	DELTA_FRAME(0x0A), 0x7C, 0x7C, 	// frame 2
+	DELTA_FRAME(0x0A), 0x3C, 0x3C, 	// frame 3
+	DELTA_FRAME(0x0A), 0x7C, 0x7C, 	// frame 4
+	DELTA_FRAME(0x0A), 0x3C, 0x3C, 	// frame 5
+	DELTA_FRAME(0x0A), 0x7C, 0x7C, 	// frame 6
 	0x20, 0x5E, 0x21, 0x5E, 0x20, 	// frame 7
 	0x10, 0x6F, 0x10, 0x6F, 0x10, 	// frame 8
 	0x08, 0x77, 0x08, 0x77, 0x08, 	// frame 9
@@ -13,7 +13,7 @@ const unsigned char rocket[] PROGMEM = {
 	0x01, 0x68, 0x01, 0x68, 0x01, 	// frame 12
 	0x20, 0x50, 0x20, 0x50, 0x20, 	// frame 13
 	0x40, 0x10, 0x20, 0x00, 0x40, 	// frame 14
-	0x20, 0x00, 0x40, 0x00, 0x40, 	// frame 15
-	0x40, 0x00, 0x40, 0x00, 0x00, 	// frame 16
+	DELTA_FRAME(0x07), 0x20, 0x00, 0x40, 	// frame 15
+	DELTA_FRAME(0x11), 0x40, 0x00, 	// frame 16
 	END_OF_DATA
 };
@@ -1,7 +1,7 @@
 const unsigned char snow[] PROGMEM = {
 	0x01, 0x00, 0x00, 0x00, 0x00, 	// frame 1
-	0x02, 0x00, 0x01, 0x00, 0x00, 	// frame 2
-	0x04, 0x00, 0x02, 0x00, 0x00, 	// frame 3
+	DELTA_FRAME(0x05), 0x02, 0x01, 	// frame 2
+	DELTA_FRAME(0x05), 0x04, 0x02, 	// frame 3
 	0x08, 0x01, 0x04, 0x00, 0x01, 	// frame 4
 	0x10, 0x02, 0x08, 0x00, 0x02, 	// frame 5
 	0x20, 0x04, 0x11, 0x00, 0x04, 	// frame 6
@@ -12,10 +12,10 @@ const unsigned char snow[] PROGMEM = {
 	0x54, 0x40, 0x60, 0x08, 0x42, 	// frame 11
 	0x68, 0x41, 0x60, 0x11, 0x44, 	// frame 12
 	0x70, 0x42, 0x60, 0x22, 0x48, 	// frame 13
-	0x70, 0x44, 0x60, 0x45, 0x50, 	// frame 14
-	0x70, 0x48, 0x60, 0x4A, 0x50, 	// frame 15
-	0x70, 0x50, 0x60, 0x54, 0x60, 	// frame 16
-	0x70, 0x60, 0x60, 0x68, 0x60, 	// frame 17
-	0x70, 0x60, 0x60, 0x70, 0x60, 	// frame 18
+	DELTA_FRAME(0x1A), 0x44, 0x45, 0x50, 	// frame 14
+	DELTA_FRAME(0x0A), 0x48, 0x4A, 	// frame 15
+	DELTA_FRAME(0x1A), 0x50, 0x54, 0x60, 	// frame 16
+	DELTA_FRAME(0x0A), 0x60, 0x68, 	// frame 17
+	DELTA_FRAME(0x08), 0x70, 		// frame 18
 	END_OF_DATA
 };
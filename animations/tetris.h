@@ -1,37 +1,37 @@
 const unsigned char tetris[] PROGMEM = {
 	0x00, 0x00, 0x07, 0x00, 0x00, 	// frame 1
-	0x00, 0x00, 0x0E, 0x00, 0x00, 	// frame 2
-	0x00, 0x08, 0x08, 0x08, 0x00, 	// frame 3
+	DELTA_FRAME(0x04), 0x0E, 		// frame 2
+	DELTA_FRAME(0x0E), 0x08, 0x08, 0x08, 	// frame 3
 	0x10, 0x10, 0x10, 0x00, 0x00, 	// frame 4
-	0x20, 0x20, 0x20, 0x00, 0x00, 	// frame 5
-	0x40, 0x43, 0x43, 0x00, 0x00, 	// frame 6
-	0x40, 0x46, 0x46, 0x00, 0x00, 	// frame 7
-	0x40, 0x40, 0x4C, 0x0C, 0x00, 	// frame 8
-	0x40, 0x40, 0x40, 0x18, 0x18, 	// frame 9
-	0x40, 0x40, 0x40, 0x60, 0x60, 	// frame 10
+	DELTA_FRAME(0x07), 0x20, 0x20, 0x20, 	// frame 5
+	DELTA_FRAME(0x07), 0x40, 0x43, 0x43, 	// frame 6
+	DELTA_FRAME(0x06), 0x46, 0x46, 	// frame 7
+	DELTA_FRAME(0x0E), 0x40, 0x4C, 0x0C, 	// frame 8
+	DELTA_FRAME(0x1C), 0x40, 0x18, 0x18, 	// frame 9
+	DELTA_FRAME(0x18), 0x60, 0x60, 	// frame 10
 	0x00, 0x00, 0x00, 0x20, 0x20, 	// frame 11
 	0x40, 0x40, 0x40, 0x60, 0x60, 	// frame 12
 	0x00, 0x01, 0x07, 0x44, 0x40, 	// frame 13
-	0x00, 0x02, 0x0E, 0x48, 0x40, 	// frame 14
-	0x00, 0x18, 0x08, 0x4C, 0x40, 	// frame 15
+	DELTA_FRAME(0x0E), 0x02, 0x0E, 0x48, 	// frame 14
+	DELTA_FRAME(0x0E), 0x18, 0x08, 0x4C, 	// frame 15
 	0x30, 0x10, 0x18, 0x40, 0x40, 	// frame 16
-	0x60, 0x20, 0x30, 0x40, 0x40, 	// frame 17
-	0x60, 0x27, 0x34, 0x40, 0x40, 	// frame 18
-	0x7E, 0x30, 0x30, 0x40, 0x40, 	// frame 19
-	0x7E, 0x31, 0x33, 0x40, 0x40, 	// frame 20
-	0x7E, 0x32, 0x36, 0x40, 0x40, 	// frame 21
-	0x7E, 0x30, 0x36, 0x44, 0x40, 	// frame 22
-	0x7E, 0x30, 0x30, 0x4C, 0x48, 	// frame 23
-	0x7E, 0x30, 0x30, 0x50, 0x58, 	// frame 24
-	0x7E, 0x30, 0x30, 0x60, 0x70, 	// frame 25
+	DELTA_FRAME(0x07), 0x60, 0x20, 0x30, 	// frame 17
+	DELTA_FRAME(0x06), 0x27, 0x34, 	// frame 18
+	DELTA_FRAME(0x07), 0x7E, 0x30, 0x30, 	// frame 19
+	DELTA_FRAME(0x06), 0x31, 0x33, 	// frame 20
+	DELTA_FRAME(0x06), 0x32, 0x36, 	// frame 21
+	DELTA_FRAME(0x0A), 0x30, 0x44, 	// frame 22
+	DELTA_FRAME(0x1C), 0x30, 0x4C, 0x48, 	// frame 23
+	DELTA_FRAME(0x18), 0x50, 0x58, 	// frame 24
+	DELTA_FRAME(0x18), 0x60, 0x70, 	// frame 25
 	0x5E, 0x10, 0x10, 0x40, 0x50, 	// frame 26
 	0x7E, 0x30, 0x30, 0x60, 0x70, 	// frame 27
 	0x7C, 0x20, 0x20, 0x40, 0x60, 	// frame 28
-	0x7C, 0x21, 0x27, 0x44, 0x60, 	// frame 29
-	0x7C, 0x22, 0x2E, 0x48, 0x60, 	// frame 30
-	0x7C, 0x38, 0x28, 0x4C, 0x60, 	// frame 31
-	0x7C, 0x3B, 0x2B, 0x4C, 0x60, 	// frame 32
-	0x7C, 0x3E, 0x2E, 0x4C, 0x60, 	// frame 33
-	0x7C, 0x3F, 0x2F, 0x4D, 0x60, 	// frame 34
+	DELTA_FRAME(0x0E), 0x21, 0x27, 0x44, 	// frame 29
+	DELTA_FRAME(0x0E), 0x22, 0x2E, 0x48, 	// frame 30
+	DELTA_FRAME(0x0E), 0x38, 0x28, 0x4C, 	// frame 31
+	DELTA_FRAME(0x06), 0x3B, 0x2B, 	// frame 32
+	DELTA_FRAME(0x06), 0x3E, 0x2E, 	// frame 33
+	DELTA_FRAME(0x0E), 0x3F, 0x2F, 0x4D, 	// frame 34
 	END_OF_DATA
 };
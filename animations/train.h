@@ -7,7 +7,7 @@ const unsigned char train[] PROGMEM = {
 	0x69, 0x2F, 0x29, 0x29, 0x2F, 	// frame 6
 	0x69, 0x69, 0x3F, 0x21, 0x00, 	// frame 7
 	0x00, 0x20, 0x3E, 0x62, 0x62, 	// frame 8
-	0x23, 0x23, 0x23, 0x62, 0x62, 	// frame 9
+	DELTA_FRAME(0x07), 0x23, 0x23, 0x23, 	// frame 9
 	0x3E, 0x20, 0x00, 0x00, 0x3C, 	// frame 10
 	0x64, 0x7C, 0x24, 0x3C, 0x24, 	// frame 11
 	0x3C, 0x24, 0x7C, 0x64, 0x3C, 	// frame 12
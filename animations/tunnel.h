@@ -1,6 +1,6 @@
 const unsigned char tunnel[] PROGMEM = {
 	0x00, 0x00, 0x1C, 0x00, 0x00, 	// frame 1
-	0x00, 0x3E, 0x22, 0x3E, 0x00, 	// frame 2
+	DELTA_FRAME(0x0E), 0x3E, 0x22, 0x3E, 	// frame 2
 	0x7F, 0x41, 0x41, 0x41, 0x7F, 	// frame 3
 	END_OF_DATA
 };
@@ -2,8 +2,8 @@ const unsigned char tv_off[] PROGMEM = {
 	0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 	// frame 1
 	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 	// frame 2
 	0x08, 0x08, 0x08, 0x08, 0x08, 	// frame 3
-	0x08, 0x08, 0x08, 0x08, 0x08, 	// frame 4
-	0x00, 0x08, 0x08, 0x08, 0x00, 	// frame 5
-	0x00, 0x00, 0x08, 0x00, 0x00, 	// frame 6
+	REPEAT_FRAME(1),				// frame 4
+	DELTA_FRAME(0x11), 0x00, 0x00, 	// frame 5
+	DELTA_FRAME(0x0A), 0x00, 0x00, 	// frame 6
 	END_OF_DATA
 };
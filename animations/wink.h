@@ -1,10 +1,9 @@
 const unsigned char wink[] PROGMEM = {
+	FRAME_TIME(3),
 	0x00, 0x26, 0x20, 0x26, 0x00, 	// frame 1
-	0x00, 0x26, 0x20, 0x26, 0x00, 	// frame 2
-	0x00, 0x26, 0x20, 0x26, 0x00, 	// frame 3
-	0x00, 0x26, 0x20, 0x24, 0x00, 	// frame 4
-	0x00, 0x26, 0x20, 0x26, 0x00, 	// frame 5
-	0x00, 0x26, 0x20, 0x26, 0x00, 	// frame 6
-	0x10, 0x26, 0x20, 0x26, 0x10, 	// frame 7
+	DELTA_FRAME(0x08), 0x24, 		// frame 2
+	FRAME_TIME(2),
+	DELTA_FRAME(0x08), 0x26, 		// frame 3
+	DELTA_FRAME(0x11), 0x10, 0x10, 	// frame 4
 	END_OF_DATA
 };
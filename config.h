@@ -39,72 +39,130 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 #endif
 
 // timing
-#define COLUMN_FREQ			1000		// display column frequency [Hz]
+// The display columns are multiplexed by timer 1 (CTC mode, prescaler 1:8, 0.5 us resolution
+// at 16 MHz), the system timer runs on timer 0 (prescaler 1:1024).
+#define COLUMN_FREQ			1000		// display column frequency [Hz] (range 250..20000, e. g. 4000 for filming)
 #define SYS_TIMER_FREQ		100			// system timer frequency [Hz]
-#define OCR0A_CYCLE_TIME	(uint8_t)(F_CPU / 1024.0 / COLUMN_FREQ + 0.5);
-#define OCR0B_CYCLE_TIME	(uint8_t)(F_CPU / 1024.0 / SYS_TIMER_FREQ + 0.5);
+#define COLUMN_TIME			((F_CPU / 8 + COLUMN_FREQ / 2) / COLUMN_FREQ)	// column time [timer 1 ticks]
+#define ICR1_CYCLE_TIME		(COLUMN_TIME - 1)
+#define OCR0B_CYCLE_TIME	(uint8_t)(F_CPU / 1024.0 / SYS_TIMER_FREQ + 0.5)
+
+// resulting display timing (for information, e. g. to judge flicker)
+#define COLUMN_FREQ_ACTUAL	(F_CPU / 8.0 / COLUMN_TIME)				// actual column frequency [Hz]
+#define REFRESH_FREQ		(COLUMN_FREQ_ACTUAL / DISP_SLOTS)		// refresh frequency of the whole display [Hz]
+#define DUTY_CYCLE			(100.0 / DISP_SLOTS)					// maximum on-time of a led [%]
+
+// brightness and grayscale timing (timer 1)
+// Timer 1 restarts at the beginning of every column. Compare match B ends
+// the on-time of the column, compare match A switches to the low-order bit plane
+// in grayscale mode (after 2/3 of the on-time). So there are at most two short
+// timer 1 compare interrupts per column (about 40 cycles each).
+#define BRIGHTNESS_STEPS	16			// number of brightness levels (range 1..COLUMN_TIME)
+#define BRIGHTNESS_DEFAULT	15			// brightness after reset (BRIGHTNESS_STEPS - 1 = maximum)
 
 // push button
 #define PB_PORT				PORTD
 #define PB_PIN				PIND
 #define PB_BIT				0			// bit number of the pin where the push button is connected
 #define PB_LONGPRESS_DELAY	100			// number of system timer cycles after which a longpress event is issued
+#define PB_DEBOUNCE			3			// number of successive system timer cycles the button has to be pressed
+										// before a press event is issued (at least 2, see UART_UPLOAD)
+#define PB_DOUBLE_DELAY		30			// number of system timer cycles after a short press within which
+										// the next press is a double press
 
 // bit masks for push button events (do not change)
 #define PB_PRESS			(1<<0)					// 1 = pressed, 0 = released
 #define PB_RELEASE			(0<<0)
 #define PB_LONG				(1<<1)					// 1 = long press, 0 = short press
+#define PB_DOUBLE			(1<<2)					// 1 = second press of a double press
 #define PB_ACK				(1<<7)					// 1 = key event has been processed
 #define PB_LONGPRESS		(PB_PRESS|PB_LONG)
 #define PB_MASK				(1<<PB_BIT)				// mask to extract button state
 
+// sleep mode (a long button press puts the display to sleep, the next press wakes it up)
+//#define FAST_RESUME					// if defined -> the display continues the current message where it has been put
+										// to sleep instead of showing smileys and restarting with the first message
+										// (the first column is shown right after the wake-up, see wake_latency in main.c)
+
+// serial message upload (see UploadService() in main.c and tools/msgupload.py)
+//#define UART_UPLOAD					// if defined -> messages can be uploaded via the serial port (RXD = PD0, TXD = PD1)
+										// The push button shares PD0 with RXD. A press holds the line low for much
+										// longer than a character, so it is received as a break (framing error) and
+										// discarded, while the button is ignored for UART_TIMEOUT after every valid byte.
+#define UART_BAUD			9600		// baud rate (8 data bits, no parity, 1 stop bit)
+#define UART_RX_SIZE		32			// size of the receive buffer (range 2..128, power of 2)
+#define UART_BLOCK_SIZE		16			// maximum number of message bytes per frame
+#define UART_TIMEOUT		10			// number of system timer cycles without data after which an incomplete frame is dropped
+										// and the push button is evaluated again
+#define UART_UBRR			((F_CPU / 8 + UART_BAUD / 2) / UART_BAUD - 1)	// (double speed mode)
+
+// live text via the serial port (see LiveText() in main.c and tools/livetext.py)
+//#define UART_LIVE						// if defined -> text can be streamed to the display after a UART_CMD_LIVE frame
+										// (needs UART_UPLOAD and DISP_STREAMING, XON/XOFF flow control)
+#define UART_XOFF_LEVEL		(UART_RX_SIZE / 2)	// number of buffered bytes at which XOFF is sent
+#define UART_XON_LEVEL		(UART_RX_SIZE / 4)	// number of buffered bytes at which XON is sent again
+
+// frame format of the upload protocol (do not change)
+// A frame consists of UART_SYNC, the command, the number of data bytes, the data bytes and the
+// CRC-16 (CCITT, reflected, initial value 0xFFFF, low byte first) of command, length and data.
+// Every valid frame is answered with UART_ACK when it has been executed, an invalid one with UART_NAK.
+#define UART_SYNC			0x7E
+#define UART_CMD_WRITE		'W'			// data = offset in messages[], message bytes (1..UART_BLOCK_SIZE)
+#define UART_CMD_DONE		'D'			// no data, rebuild the message directory and show the first message
+#define UART_CMD_LIVE		'L'			// data = mode byte, the following bytes are shown as live text until UART_EOT
+										// (characters as in messages, '\n' = long space, other control codes are ignored)
+#define UART_EOT			0x04		// end of live text
+#define UART_XON			0x11
+#define UART_XOFF			0x13
+#define UART_ACK			0x06
+#define UART_NAK			0x15
+
+#if UART_RX_SIZE & (UART_RX_SIZE - 1)
+	#error "UART_RX_SIZE must be a power of 2"
+#endif
+#if defined(UART_LIVE) && !defined(UART_UPLOAD)
+	#error "UART_LIVE needs UART_UPLOAD"
+#endif
+
+// message encoding
+//#define MSG_UTF8						// if defined -> message texts are UTF-8 encoded (characters beyond U+00FF
+										// are shown as '?', bytes that are not part of a UTF-8 sequence as before)
+
+#ifndef __ASSEMBLER__
+
 // messages in EEPROM
 #define MSG_SIZE	256			// number of EEPROM bytes reserved for messages
+#define MSG_CACHE_SIZE	16		// number of message bytes that are read from EEPROM at once
+#define MSG_MAX		40			// maximum number of messages (size of the message directory)
+#define EEPROM_WRITE_WINDOW	(COLUMN_TIME - 40)	// EEPROM writes are started only up to this timer 1 value, so the
+												// interrupt lock of a write never delays the next column (20 us)
 
-// default message data
+#if MSG_SIZE > 256
+	#error "MSG_SIZE must not exceed 256 (the message directory stores 8 bit offsets)"
+#endif
+
+// message directory
+// Offsets of all messages in messages[], so any message can be selected without scanning
+// the message data. The directory is checked at every start and rebuilt from the message
+// data if it does not match (see CheckDirectory() in main.c).
+typedef struct {
+	uint8_t count;					// number of messages
+	uint8_t offset[MSG_MAX + 1];	// offset of every message and of the end of the list (mode byte 0)
+	uint8_t check;					// checksum (count + used offsets + check = 0 modulo 256)
+} msg_dir_t;
+
+// default message data and message directory
 // A message is either a text or an animation to be displayed on the dot matrix.
-// Note: Between each two characters of a string there will be a space of 1 column.
-//		0x20 = normal space (3+1 columns)
-//		0x7F = short space (0+1 column)
-//		0x9D = long space (5+1 columns), may be used as the last frame of an animation
-const uint8_t messages[MSG_SIZE] EEMEM = {
-	0x53, ' ', 'H', 'a', 'c', 'k', ' ', 'y', 'o', 'u', 'r', ' ', 's', 'c', 'h', 'o', 'o', 'l', 0x9d, 0x00,
-	0x53, ' ', 'T', 'e', 'l', 'e', 'o', '-', 'c', 0x9d, 0x00,
-	0x64, ' ', 'I', ' ', '^', 'R', ' ', 'C', 'h', 'a', 'o', 's', 'd', 'o', 'r', 'f', 0x9D, 0x00,
-	0xC4, 0x8B, ' ', 0x8C, ' ', 0x8E, ' ', 0x8D, 0x00,							// Monster
-	0x0B, 0xA3, ' ', 0xA5, ' ', 0xA6, ' ', 0xA0, ' ', 0x00,						// break-dance
-	0x04, ' ', '^', 'S', '^', 'S', '^', 'S', 0x9D, 0x00,						// turn left
-	0x04, ' ', 0x94, 0x95, 0x95, ' ',  0x94, ' ', 0x95, 0x7F, 0x94, 0x9D, 0x00,	// music
-	0x95, ' ', '|', ' ', 0x00,			// scan
-	0x6C, '~', 'A', 0x00,				// arrow
-	0x0D, '~', 'B', 0x00,				// fire
-	0x4B, '~', 'C', 0x9D, 0x00,			// bounce
-	0x84, '~', 'D', 0x00,				// creeper
-	0x4A, '~', 'E', 0x00,				// snow
-	0x3D, '~', 'F', 0x9D, 0x00,			// tunnel
-	0x5A, '~', 'G', 0x00,				// wink
-	0x34, '~', 'H', 0x00,				// ecg
-	0x0E, '~', 'I', 0x00,				// crazy checkers
-	0x4A, 0x91, ' ', 0x91, 0x9D, 0x00,	// heartbeat
-	0x49, '~', 'J', 0x00,				// tetris
-	0x5B, '~', 'K', 0x00,				// glider
-	0x8B, '~', 'L', 0x9D, 0x00,			// hop
-	0x6B, '~', 'M', 0x00,				// pong
-	0x38, ' ', 0x9D, '~', 'N', 0x00,	// house
-	0x6B, '~', 'O', 0x9D, 0x00,			// rocket
-	0x64, 0x9D, '~', 'P', 0x9D, 0x00,	// train
-	0x5B, '3', '3', 0x7F, ' ', '2', '2', 0x7F, ' ', 0x7F, '1', 0x7F, '1', '~', 'Q', 0x9D, 0x00,	// explode
-	0x6C, '~', 'R', 0x00,				// droplet
-	0x0E, '~', 'S', 0x00,				// psycho
-	0x7D, '~', 'T', 0x9D, 0x00,			// TV off
-	0x0D, '~', 'U', 0x00,				// clock
-	0x00
-};
+// The messages are edited in the playlist messages.txt and compiled into messages.h
+// by tools/msgcompile.py (make messages), see DisplayMessage() in main.c for the format.
+#include "messages.h"
 
 // speed and delay conversion
 // Convert speed / delay parameters from mode byte (range 0..7) to actual speed / delay values.
 const uint8_t dly_conv[] PROGMEM = {0, 1, 2, 3, 5, 8, 13, 21};
 const uint8_t spd_conv[] PROGMEM = {50, 30, 18, 11, 7, 5, 3, 2};
 
+#endif /* __ASSEMBLER__ */
+
 
 #endif /* CONFIG_H_ */
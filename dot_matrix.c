@@ -25,12 +25,14 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 **********************************************************************************/
 
 #include <inttypes.h>
+#include <stddef.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
 #include <avr/eeprom.h>
+#include <util/atomic.h>
 #include "dot_matrix.h"
-#include "Font_5x7_extended.h"
+#include "Font_5x7_packed.h"
 
 
 /********************
@@ -49,41 +51,167 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 	const uint8_t row_bit[]  PROGMEM = {(1<<R1), (1<<R2), (1<<R3), (1<<R4), (1<<R5), (1<<R6), (1<<R7)};
 #endif
 
+#ifdef DISP_PORT_LUT
+	// Lookup tables for the port outputs, generated at compile time from the connection map.
+	// row_lut_x[pattern] contains the row bits of port x for a column bit pattern.
+	// col_lut_x[col] contains the column bits of port x that switch on column col only
+	// (col = DISP_COLUMNS switches all columns off), already inverted for common anode displays.
+	#define ROW_OUT(p, n, port, bit, x)		(((((p) >> (n)) & 1) && ((port) == (x))) ? (1 << (bit)) : 0)
+	#define COL_OUT(c, n, port, bit, x)		((((c) != (n)) && ((port) == (x))) ? (1 << (bit)) : 0)
+	#ifdef DISP_UPDOWN
+		#define ROW_BITS(p, x)	(ROW_OUT(p, 0, R7_PORT, R7, x) | ROW_OUT(p, 1, R6_PORT, R6, x) | ROW_OUT(p, 2, R5_PORT, R5, x) | \
+								 ROW_OUT(p, 3, R4_PORT, R4, x) | ROW_OUT(p, 4, R3_PORT, R3, x) | ROW_OUT(p, 5, R2_PORT, R2, x) | \
+								 ROW_OUT(p, 6, R1_PORT, R1, x))
+		#define COL_BITS(c, x)	(COL_OUT(c, 0, C5_PORT, C5, x) | COL_OUT(c, 1, C4_PORT, C4, x) | COL_OUT(c, 2, C3_PORT, C3, x) | \
+								 COL_OUT(c, 3, C2_PORT, C2, x) | COL_OUT(c, 4, C1_PORT, C1, x))
+	#else
+		#define ROW_BITS(p, x)	(ROW_OUT(p, 0, R1_PORT, R1, x) | ROW_OUT(p, 1, R2_PORT, R2, x) | ROW_OUT(p, 2, R3_PORT, R3, x) | \
+								 ROW_OUT(p, 3, R4_PORT, R4, x) | ROW_OUT(p, 4, R5_PORT, R5, x) | ROW_OUT(p, 5, R6_PORT, R6, x) | \
+								 ROW_OUT(p, 6, R7_PORT, R7, x))
+		#define COL_BITS(c, x)	(COL_OUT(c, 0, C1_PORT, C1, x) | COL_OUT(c, 1, C2_PORT, C2, x) | COL_OUT(c, 2, C3_PORT, C3, x) | \
+								 COL_OUT(c, 3, C4_PORT, C4, x) | COL_OUT(c, 4, C5_PORT, C5, x))
+	#endif
+	#if DISP_TYPE == 1
+		#define COL_INV(mask)	(mask)
+	#else
+		#define COL_INV(mask)	0
+	#endif
+	#define ROW_LUT4(p, x)		ROW_BITS(p, x), ROW_BITS((p)+1, x), ROW_BITS((p)+2, x), ROW_BITS((p)+3, x)
+	#define ROW_LUT16(p, x)		ROW_LUT4(p, x), ROW_LUT4((p)+4, x), ROW_LUT4((p)+8, x), ROW_LUT4((p)+12, x)
+	#define ROW_LUT64(p, x)		ROW_LUT16(p, x), ROW_LUT16((p)+16, x), ROW_LUT16((p)+32, x), ROW_LUT16((p)+48, x)
+	#define ROW_LUT(x)			{ ROW_LUT64(0, x), ROW_LUT64(64, x) }
+	#define COL_LUT(x, mask)	{ COL_BITS(0, x) ^ COL_INV(mask), COL_BITS(1, x) ^ COL_INV(mask), \
+								  COL_BITS(2, x) ^ COL_INV(mask), COL_BITS(3, x) ^ COL_INV(mask), \
+								  COL_BITS(4, x) ^ COL_INV(mask), COL_BITS(5, x) ^ COL_INV(mask) }
+
+	const uint8_t row_lut_b[128] PROGMEM = ROW_LUT(B);
+	const uint8_t row_lut_c[128] PROGMEM = ROW_LUT(C);
+	const uint8_t row_lut_d[128] PROGMEM = ROW_LUT(D);
+	const uint8_t col_lut_b[DISP_COLUMNS + 1] PROGMEM = COL_LUT(B, DISP_MASK_B);
+	const uint8_t col_lut_c[DISP_COLUMNS + 1] PROGMEM = COL_LUT(C, DISP_MASK_C);
+	const uint8_t col_lut_d[DISP_COLUMNS + 1] PROGMEM = COL_LUT(D, DISP_MASK_D);
+#endif
+
 // The display memory contains all the data to be displayed. Of the display memory
 // only a small window, whose size matches the dot matrix display, is actually displayed.
+// In grayscale mode every led has a 2 bit brightness level. Bit 1 of the level is
+// stored in memory[] and displayed for 2/3 of the column time, bit 0 is stored
+// in lsb[] and displayed for the remaining 1/3 (binary code modulation).
 typedef struct {
 	uint8_t memory[DISP_MAX];	// display memory (every byte encodes a column)
-	uint8_t base;				// index of column 1 of currently displayed window
+	#ifdef DISP_GRAYSCALE
+	uint8_t lsb[DISP_MAX];		// low-order bit plane of the display memory
+	#endif
+	uint8_t cursor;				// index of first free byte after current display content (0 = empty display)
+} buffer_t;
+
+// With double buffering the front buffer is displayed while the back buffer is written.
+// Both are swapped at the start of a refresh cycle after dmShow() has been called.
+typedef struct {
+	buffer_t buffer[DISP_BUFFERS];
+	#if DISP_BUFFERS > 1
+	buffer_t* volatile front;	// buffer that is displayed
+	buffer_t* volatile back;	// buffer that is written to
+	volatile uint8_t swap;		// 1 = swap buffers at the start of the next refresh cycle
+	uint8_t stopped;			// 1 = dmDisplay() is not called (see dmStop()), buffers are swapped at once
+	#endif
+	uint8_t base;				// index of column 1 of the window set by scrolling
+	uint8_t window;				// index of column 1 of currently displayed window
+								// (= base, but only updated at the start of a refresh cycle)
 	uint8_t curr_col;			// index of currently displayed column within window
 	uint8_t scroll_mode;		// lower nibble = increment of display base for each scrolling step (0 = off)
 	// bit 4 = direction (0 = forward, 1 = backward)
 	// bit 5 = bidirectional (0 = off, 1 = on)
-	uint8_t cursor;				// index of first free byte after current display content (0 = empty display)
 	uint8_t scroll_delay;		// delay (number of scrolling steps) before scrolling cycle restarts
 	uint8_t delay_counter;		// counter for scroll delays (counting down to zero)
+	uint16_t tear_count;		// number of scrolling steps that happened in the middle of a refresh cycle
+	#ifdef DISP_MARQUEE
+	uint8_t period;				// number of columns after which the content repeats (marquee mode, 0xFF = no repetition)
+	#endif
+	#ifdef DISP_STREAMING
+	uint8_t msg_end;			// index of first byte after the end of the message (streaming mode)
+	volatile uint8_t end_pending;	// 1 = msg_end is valid and has not been reached by scrolling yet
+	#endif
 } display_t;
 
 display_t display;
 
+#ifdef DISP_ASM_ISR
+	// The assembler display interrupt keeps the current column and window in GPIOR0/1.
+	#define CURR_COL	GPIOR0
+	_Static_assert(offsetof(display_t, base) == DISP_OFS_BASE, "DISP_OFS_BASE does not match display_t");
+#else
+	#define CURR_COL	display.curr_col
+#endif
+
+#if DISP_BUFFERS > 1
+	#define FRONT		(display.front)
+	#define BACK		(display.back)
+#else
+	#define FRONT		(&display.buffer[0])
+	#define BACK		(&display.buffer[0])
+#endif
+
+// In streaming mode the display memory is a ring buffer. The indices (base, window,
+// cursor) count up freely and only their lower bits address the display memory.
+#ifdef DISP_STREAMING
+	#define MEM_INDEX(i)	((uint8_t)(i) & (DISP_MAX - 1))
+	#define MEM_FULL(pos)	((uint8_t)((pos) - display.window) >= DISP_MAX)
+#else
+	#define MEM_INDEX(i)	(i)
+	#define MEM_FULL(pos)	((pos) >= DISP_MAX)
+#endif
+
 /**********
  * makros *
  **********/
 
+// width of a glyph of the packed font
+#define FONT_WIDTH(i)	((pgm_read_byte(&font_width[(i) >> 1]) >> (((i) & 1) << 2)) & 0x0F)
+
 #define BIT_IS_ON	(pattern & 1)
 #define NEXT_BIT	pattern >>= 1
 #define COL			col
 
 // Usage: swap(b)
+#ifdef __AVR__
 #define swap(x) 											\
 	({														\
 		asm volatile ("swap %0" : "=r" (x) : "0" (x));		\
 	})
+#else
+#define swap(x)		((x) = (uint8_t)(((x) << 4) | ((x) >> 4)))	// (host build of the tests)
+#endif
 
 
 /*************
  * functions *
  *************/
 
+#if DISP_BUFFERS > 1
+/*======================================================================
+	Function:		SwapBuffers
+	Input:			none
+	Output:			none
+	Description:	Swap the front and the back buffer and show the new front
+					buffer from its beginning. Call with interrupts disabled.
+======================================================================*/
+static inline void SwapBuffers(void)
+{
+	buffer_t* buf;
+
+	buf = display.front;
+	display.front = display.back;
+	display.back = buf;
+	display.base = 0;
+	display.swap = 0;
+	#ifdef DISP_MARQUEE
+	display.period = 0xFF;
+	#endif
+}
+#endif
+
+
 /*======================================================================
 	Function:		dmInit
 	Input:			none
@@ -92,9 +220,18 @@ display_t display;
 ======================================================================*/
 void dmInit(void)
 {
+	#if DISP_BUFFERS > 1
+	display.front = &display.buffer[0];
+	display.back  = &display.buffer[1];
+	display.swap  = 0;
+	#endif
 	dmClearDisplay();
 	display.scroll_mode = 0;
 	display.scroll_delay = 0;
+	#ifdef DISP_ASM_ISR
+	GPIOR0 = 0;
+	GPIOR1 = 0;
+	#endif
 }
 
 
@@ -106,6 +243,25 @@ void dmInit(void)
 	Description:	Set row and column outputs so that the leds of the specified 
 					column represent the bit pattern (1 = led on).
 ======================================================================*/
+#ifdef DISP_PORT_LUT
+
+inline void dmSetOutputs(uint8_t col, uint8_t pattern)
+{
+	uint8_t i;
+
+	// Note: Rows and columns never share a port bit, so XOR merges them
+	// and also inverts the row bits for common anode displays.
+	pattern &= 0x7F;
+	i = PORTB & ~DISP_MASK_B;
+	PORTB = i | (pgm_read_byte(&col_lut_b[col]) ^ pgm_read_byte(&row_lut_b[pattern]));
+	i = PORTC & ~DISP_MASK_C;
+	PORTC = i | (pgm_read_byte(&col_lut_c[col]) ^ pgm_read_byte(&row_lut_c[pattern]));
+	i = PORTD & ~DISP_MASK_D;
+	PORTD = i | (pgm_read_byte(&col_lut_d[col]) ^ pgm_read_byte(&row_lut_d[pattern]));
+}
+
+#else
+
 inline void dmSetOutputs(uint8_t col, uint8_t pattern)
 {
 	uint8_t i;
@@ -138,45 +294,223 @@ inline void dmSetOutputs(uint8_t col, uint8_t pattern)
 	PORTD = i | p[D];
 }
 
+#endif
+
 
 /*======================================================================
 	Function:		dmDisplay
 	Input:			none
 	Output:			none
 	Description:	Switch to the next display column and display it on the led matrix.
+					After the last column DISP_BLANK_SLOTS blank slots follow.
 					Call this function periodically, e. g. within an interrupt routine.
+					Note: dot_matrix_isr.S contains an assembler version (DISP_ASM_ISR).
 ======================================================================*/
 void dmDisplay(void)
 {
-	if (display.curr_col >= DISP_COLUMNS) {
-		display.curr_col = 0;
+	uint8_t col;
+	#ifdef DISP_MARQUEE
+	uint8_t idx;
+	#endif
+
+	col = display.curr_col + 1;
+	if (col >= DISP_SLOTS) {
+		col = 0;
+		#if DISP_BUFFERS > 1
+		if (display.swap) {					// new content -> swap buffers
+			SwapBuffers();
+		}
+		#endif
+		display.window = display.base;		// apply scrolling steps
 	}
-	else {
-		display.curr_col++;
+	display.curr_col = col;
+	#if DISP_BLANK_SLOTS > 0
+	if (col >= DISP_COLUMNS) {				// blank slot
+		dmBlank();
+		return;
+	}
+	#endif
+	#ifdef DISP_MARQUEE
+	idx = display.window + col;
+	if (idx >= display.period) { idx -= display.period; }	// wrap around
+	if (idx >= FRONT->cursor)	{ dmSetOutputs(col, 0); }	// gap between end and beginning
+		else					{ dmSetOutputs(col, FRONT->memory[idx]); }
+	#else
+	dmSetOutputs(col, FRONT->memory[MEM_INDEX(display.window + col)]);
+	#endif
+}
+
+
+/*======================================================================
+	Function:		dmBlank
+	Input:			none
+	Output:			none
+	Description:	Switch off all columns until the next call of dmDisplay().
+					Used to shorten the on-time of a column (brightness control).
+======================================================================*/
+void dmBlank(void)
+{
+	dmSetOutputs(DISP_COLUMNS, 0);
+}
+
+
+/*======================================================================
+	Function:		dmStop
+	Input:			none
+	Output:			none
+	Description:	Switch off all columns and tell the driver that dmDisplay()
+					is no longer called (e. g. because the display interrupt
+					has been disabled) until dmStart() is called. A pending
+					buffer swap is done at once, and so are the swaps requested
+					while the display is stopped, as there is no refresh cycle
+					to wait for. The display content is kept.
+======================================================================*/
+void dmStop(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		#if DISP_BUFFERS > 1
+		display.stopped = 1;
+		if (display.swap) { SwapBuffers(); }
+		#endif
+		dmBlank();
 	}
-	dmSetOutputs(display.curr_col, display.memory[display.base + display.curr_col]);
 }
 
 
+/*======================================================================
+	Function:		dmStart
+	Input:			none
+	Output:			none
+	Description:	Tell the driver that dmDisplay() is called again after 
+					dmStop(). Buffer swaps wait for the start of a refresh cycle
+					again.
+======================================================================*/
+void dmStart(void)
+{
+	#if DISP_BUFFERS > 1
+	display.stopped = 0;
+	#endif
+}
+
+
+#ifdef DISP_GRAYSCALE
+/*======================================================================
+	Function:		dmDisplayPlane
+	Input:			none
+	Output:			none
+	Description:	Switch the current display column to the low-order bit plane.
+					Call this function once per column, 2/3 of the on-time
+					after dmDisplay(), e. g. within a timer interrupt routine.
+					Its run time is constant (one column output).
+======================================================================*/
+void dmDisplayPlane(void)
+{
+	#if DISP_BLANK_SLOTS > 0
+	if (display.curr_col >= DISP_COLUMNS) { return; }	// blank slot
+	#endif
+	#ifdef DISP_MARQUEE
+	uint8_t idx;
+
+	idx = display.window + display.curr_col;
+	if (idx >= display.period) { idx -= display.period; }	// wrap around
+	if (idx >= FRONT->cursor) { return; }					// gap between end and beginning
+	dmSetOutputs(display.curr_col, FRONT->lsb[idx]);
+	#else
+	dmSetOutputs(display.curr_col, FRONT->lsb[MEM_INDEX(display.window + display.curr_col)]);
+	#endif
+}
+#endif
+
+
 /*======================================================================
 	Function:		dmScroll
 	Input:			none
 	Output:			status
 	Description:	Scroll display by one step. Returns 1 if end of scrolling range has been reached.
 					Call this function periodically, e. g. within an interrupt routine.
+					The new window is displayed from the start of the next refresh cycle on.
+					The display interrupt may interrupt this function, only the
+					update of the window is atomic. A step that overlaps a buffer 
+					swap is dropped, as the swap resets the window for the new 
+					content.
 ======================================================================*/
 uint8_t dmScroll(void)
 {
-	uint8_t temp, mode;
+	uint8_t temp, mode, cursor, base, new_base, status;
+	#if DISP_BUFFERS > 1
+	buffer_t* buf;
+	#endif
+	#ifdef DISP_MARQUEE
+	uint8_t period;
+	#endif
 
+	#if DISP_BUFFERS > 1
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {		// (window and content of the same buffer)
+		buf = FRONT;
+		base = display.base;
+	}
+	cursor = buf->cursor;
+	#else
+	base = display.base;
+	cursor = FRONT->cursor;
+	#endif
+	new_base = base;
 	mode = display.scroll_mode;
+
+	#ifdef DISP_STREAMING
+	// In streaming mode the display always scrolls forward as long as rendered columns are available.
+	// The delay is inserted when the end of the message (see dmMarkEnd()) has been reached.
 	temp = mode & 0x0F;										// extract increment
-	if (mode & 0x10)	{ temp = display.base - temp; }		// scrolling backward
+	status = 1;
+	if ((uint8_t)(cursor - base) >= (temp + DISP_COLUMNS)) {	// renderer is ahead?
+		if (display.end_pending && ((uint8_t)(display.msg_end - base) < (temp + DISP_COLUMNS))) {
+			if (display.delay_counter) {					// end of message reached
+				display.delay_counter--;
+				temp = 0;
+			}
+			else {
+				display.delay_counter = display.scroll_delay;	// reload delay counter
+				display.end_pending = 0;
+			}
+		}
+		new_base = base + temp;
+		if (temp) { status = 0; }
+	}
+	#elif defined(DISP_MARQUEE)
+	// In marquee mode the content is scrolled as a ring. The delay is inserted when the
+	// beginning of the content is displayed again.
+	temp = mode & 0x0F;										// extract increment
+	status = 1;
+	period = display.period;
+	if (cursor >= DISP_COLUMNS) {
+		mode = cursor;										// period of the ring
+		if (temp == 1) { mode += DISP_MARQUEE_GAP; }		// (no gap for frame by frame animations)
+		period = mode;
+		if (display.delay_counter) {
+			display.delay_counter--;
+		}
+		else {
+			if (display.scroll_mode & 0x10) {				// scrolling backward
+				if (base < temp)	{ temp = base + mode - temp; }
+					else			{ temp = base - temp; }
+			}
+			else {											// scrolling forward
+				temp = base + temp;
+				if (temp >= mode) { temp -= mode; }
+			}
+			new_base = temp;
+			if (temp == 0)	{ display.delay_counter = display.scroll_delay; }	// beginning reached
+				else		{ status = 0; }
+		}
+	}
+	#else
+	temp = mode & 0x0F;										// extract increment
+	if (mode & 0x10)	{ temp = base - temp; }				// scrolling backward
 															// We use a dirty trick here:
 															// Temp may underflow at left end of display memory.
-	else				{ temp = display.base + temp; }		// scrolling forward
+	else				{ temp = base + temp; }				// scrolling forward
 
-	if ((temp + DISP_COLUMNS) > display.cursor ) {			// end of scrolling range reached?
+	if ((temp + DISP_COLUMNS) > cursor ) {			// end of scrolling range reached?
 															// Note: As temp is allowed to underflow, this is 
 															// true at both ends of the display memory.
 		if (display.delay_counter) {
@@ -185,15 +519,60 @@ uint8_t dmScroll(void)
 		else {
 			display.delay_counter = display.scroll_delay;					// reload delay counter
 			if (mode & 0x20)		{ display.scroll_mode = mode ^ 0x10; }	// reverse direction
-			else if (mode &0x10)	{ display.base = display.cursor - DISP_COLUMNS; }	// restart from right end
-			else					{ display.base = 0; }					// restart from left end
+			else if (mode &0x10)	{ new_base = cursor - DISP_COLUMNS; }	// restart from right end
+			else					{ new_base = 0; }						// restart from left end
 		}
-		return (1);
+		status = 1;
 	}
 	else {
-		display.base = temp;
-		return (0);
+		new_base = temp;
+		status = 0;
+	}
+	#endif
+
+	#if DISP_BUFFERS > 1
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (FRONT == buf) {
+			display.base = new_base;
+			#ifdef DISP_MARQUEE
+			display.period = period;
+			#endif
+		}
+		else {								// a buffer swap has reset the window -> drop the step
+			new_base = base;
+		}
 	}
+	#elif defined(DISP_MARQUEE)
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {		// (window and period belong together)
+		display.base = new_base;
+		display.period = period;
+	}
+	#else
+	display.base = new_base;				// (single byte, read by the display interrupt)
+	#endif
+	if ((new_base != base) && (CURR_COL < DISP_COLUMNS - 1)) {
+		display.tear_count++;								// this step would have torn the current frame
+	}
+	return (status);
+}
+
+
+/*======================================================================
+	Function:		dmGetTearCount
+	Input:			none
+	Output:			number of scrolling steps
+	Description:	Return the number of scrolling steps that happened in the middle of 
+					a refresh cycle, i. e. the number of torn frames prevented by 
+					applying scrolling steps at the start of a refresh cycle only.
+======================================================================*/
+uint16_t dmGetTearCount(void)
+{
+	uint16_t count;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		count = display.tear_count;
+	}
+	return (count);
 }
 
 
@@ -224,41 +603,146 @@ void dmSetScrolling(uint8_t inc, uint8_t dir, uint8_t delay)
 	Output:			none
 	Description:	Set display cursor to begin of display memory and 
 					clear visible part of display memory.
+					With double buffering the back buffer is cleared, so the
+					new content will not be visible before dmShow() is called.
 ======================================================================*/
 void dmClearDisplay(void)
 {
 	uint8_t i;
+	buffer_t* buf;
 
+	#if DISP_BUFFERS > 1
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (display.stopped && display.swap) { SwapBuffers(); }	// (no refresh cycle to wait for)
+	}
+	while (display.swap) {}				// wait until a pending buffer swap is done
+	#else
 	display.base  = 0;
-	display.cursor = 0;
+	#ifdef DISP_MARQUEE
+	display.period = 0xFF;
+	#endif
+	#endif
+	#ifdef DISP_STREAMING
+	display.window = 0;					// free the whole display memory
+	display.end_pending = 0;
+	#endif
+	buf = BACK;
+	buf->cursor = 0;
 	for (i = 0; i < DISP_COLUMNS; i++) {
-		display.memory[i] = 0;
+		buf->memory[i] = 0;
+		#ifdef DISP_GRAYSCALE
+		buf->lsb[i] = 0;
+		#endif
 	}
 }
 
 
 /*======================================================================
-	Function:		dmDisplayImage
-	Input:			pointer to graphics data in flash memory
+	Function:		dmShow
+	Input:			none
 	Output:			none
-	Description:	Copy flash contents to display memory at current cursor position 
-					until the end-of-data marker (0xFF) is reached.
+	Description:	Show the content written since dmClearDisplay().
+					With double buffering the buffers are swapped at the start
+					of the next refresh cycle (within DISP_SLOTS column times).
+					While the display is stopped (see dmStop()) they are 
+					swapped at once.
+					Without double buffering this function does nothing.
 ======================================================================*/
-void dmDisplayImage(const uint8_t* image)
+void dmShow(void)
 {
-	uint8_t img_data, pos;
+	#if DISP_BUFFERS > 1
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (display.stopped)	{ SwapBuffers(); }
+			else				{ display.swap = 1; }
+	}
+	#endif
+}
 
-	pos = display.cursor;
-	while(pos < DISP_MAX) {
-		img_data = pgm_read_byte(image++);	// read byte from flash
-		if (img_data == 0xFF) { break; }	// stop if end-of-data has been reached
-		display.memory[pos] = img_data;
-		pos++;
+
+/*======================================================================
+	Function:		dmShowFrame
+	Input:			pointer to DISP_COLUMNS bytes (one byte per column)
+	Output:			none
+	Description:	Replace the display content by a frame of DISP_COLUMNS
+					columns and show it (e. g. a frame of an animation).
+					Unlike dmClearDisplay() and dmPrintByte() the frame is
+					written before the window is reset, so without double
+					buffering the display never shows blank or partial
+					columns, the columns only change one by one.
+======================================================================*/
+void dmShowFrame(const uint8_t* frame)
+{
+	uint8_t i;
+	buffer_t* buf;
+
+	#if DISP_BUFFERS > 1
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (display.stopped && display.swap) { SwapBuffers(); }	// (no refresh cycle to wait for)
+	}
+	while (display.swap) {}				// wait until a pending buffer swap is done
+	#endif
+	buf = BACK;
+	for (i = 0; i < DISP_COLUMNS; i++) {
+		buf->memory[i] = frame[i];
+		#ifdef DISP_GRAYSCALE
+		buf->lsb[i] = frame[i];
+		#endif
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		buf->cursor = DISP_COLUMNS;
+		#if DISP_BUFFERS == 1
+		display.base = 0;
+		#ifdef DISP_MARQUEE
+		display.period = 0xFF;
+		#endif
+		#endif
+		#ifdef DISP_STREAMING
+		display.window = 0;
+		display.end_pending = 0;
+		#endif
 	}
-	display.cursor = pos;
+	dmShow();
 }
 
 
+/*======================================================================
+	Function:		dmFree
+	Input:			none
+	Output:			number of bytes
+	Description:	Return the number of free bytes in display memory, i. e. the
+					number of columns that can still be printed.
+					In streaming mode the columns that have been scrolled out 
+					of the display are free again.
+======================================================================*/
+uint8_t dmFree(void)
+{
+	#ifdef DISP_STREAMING
+	return (DISP_MAX - (uint8_t)(BACK->cursor - display.window));
+	#else
+	return (DISP_MAX - BACK->cursor);
+	#endif
+}
+
+
+#ifdef DISP_STREAMING
+/*======================================================================
+	Function:		dmMarkEnd
+	Input:			none
+	Output:			1 = ok, 0 = previous end of message has not been displayed yet
+	Description:	Mark the current cursor position as the end of the message.
+					When scrolling reaches this position, the scrolling delay is
+					inserted. Only one end of message can be marked at a time.
+======================================================================*/
+uint8_t dmMarkEnd(void)
+{
+	if (display.end_pending) { return (0); }
+	display.msg_end = BACK->cursor;
+	display.end_pending = 1;
+	return (1);
+}
+#endif
+
+
 /*======================================================================
 	Function:		dmPrintByte
 	Input:			byte
@@ -268,12 +752,17 @@ void dmDisplayImage(const uint8_t* image)
 void dmPrintByte(uint8_t byt)
 {
 	uint8_t pos;
-
-	pos = display.cursor;
-	if (pos < DISP_MAX) { 
-		display.memory[pos] = byt;
+	buffer_t* buf;
+
+	buf = BACK;
+	pos = buf->cursor;
+	if (!MEM_FULL(pos)) { 
+		buf->memory[MEM_INDEX(pos)] = byt;
+		#ifdef DISP_GRAYSCALE
+		buf->lsb[MEM_INDEX(pos)] = byt;
+		#endif
 		pos++;
-		display.cursor = pos;
+		buf->cursor = pos;
 	}
 }
 
@@ -283,39 +772,118 @@ void dmPrintByte(uint8_t byt)
 	Input:			character code
 	Output:			none
 	Description:	Print character to display memory at current display cursor.
+					The character code is mapped to a glyph by font_map[]
+					(codes 128..175 = special characters, Latin-1 letters from
+					192 on = umlauts or base letters of accented letters).
 ======================================================================*/
 void dmPrintChar(uint8_t ch)
 {
-	uint8_t  i, pos, char_data;
-	uint16_t fnt;			// pointer into character font
-
-	// mapping of german special characters
-	if (ch == 223) { ch = 138; }		// ''
-	if (ch == 196) { ch = 133; }		// ''
-	if (ch == 214) { ch = 135; }		// ''
-	if (ch == 220) { ch = 137; }		// ''
-	if (ch == 228) { ch = 132; }		// ''
-	if (ch == 246) { ch = 134; }		// ''
-	if (ch == 252) { ch = 136; }		// ''
-	ch -= 32;
-	if (ch > (sizeof(font)/CHAR_WIDTH)) { return; }
-		
-	fnt = ch;
-	fnt = (fnt << 2) + fnt + (uint16_t) &font[0];		// fnt = &font + 5 * ch
-	
-	pos = display.cursor;
-	for (i = 0; i < CHAR_WIDTH; i++) {
-		char_data = pgm_read_byte(fnt++);	// read byte from font
-		if (char_data & 0x80) { break; }	// stop if MSB is set (proportional character width)
-		if (pos < DISP_MAX) {
-			display.memory[pos] = char_data;
-			pos++;
-		}		
+	uint8_t  pos, width;
+	const uint8_t* fnt;		// pointer into character font
+	buffer_t* buf;
+
+	if (ch < FONT_FIRST) { return; }
+	ch = pgm_read_byte(&font_map[ch - FONT_FIRST]);	// glyph number
+	if (ch >= FONT_COUNT) { return; }				// no glyph
+
+	// locate the glyph: offset of its group plus its offset within the group
+	fnt = font_data + pgm_read_word(&font_offset[ch / FONT_GROUP]) + pgm_read_byte(&font_start[ch]);
+	width = FONT_WIDTH(ch);
+
+	buf = BACK;
+	pos = buf->cursor;
+	#ifdef DISP_STREAMING
+	while (width-- && !MEM_FULL(pos)) {		// ring buffer -> copy column by column
+		buf->memory[MEM_INDEX(pos)] = pgm_read_byte(fnt);
+		#ifdef DISP_GRAYSCALE
+		buf->lsb[MEM_INDEX(pos)] = pgm_read_byte(fnt);
+		#endif
+		fnt++;
+		pos++;
+	}
+	#else
+	if (width > DISP_MAX - pos) { width = DISP_MAX - pos; }		// clip at the end of display memory
+	memcpy_P(&buf->memory[pos], fnt, width);
+	#ifdef DISP_GRAYSCALE
+	memcpy_P(&buf->lsb[pos], fnt, width);
+	#endif
+	pos += width;
+	#endif
+	buf->cursor = pos;
+}
+
+
+#ifdef DISP_GRAYSCALE
+/*======================================================================
+	Function:		dmPrintGray
+	Input:			high-order bit plane of the column
+					low-order bit plane of the column
+	Output:			none
+	Description:	Write a column with brightness levels directly to the display memory.
+					The level of a led is (2 * hi bit + lo bit).
+======================================================================*/
+void dmPrintGray(uint8_t hi, uint8_t lo)
+{
+	uint8_t pos;
+	buffer_t* buf;
+
+	buf = BACK;
+	pos = buf->cursor;
+	if (!MEM_FULL(pos)) { 
+		buf->memory[MEM_INDEX(pos)] = hi;
+		buf->lsb[MEM_INDEX(pos)] = lo;
+		pos++;
+		buf->cursor = pos;
 	}
-	display.cursor = pos;
 }
 
 
+/*======================================================================
+	Function:		dmDisplayGrayImage
+	Input:			pointer to graphics data in flash memory
+	Output:			none
+	Description:	Copy grayscale image from flash to display memory at current 
+					cursor position until the end-of-data marker (0xFF) is reached.
+					Every column is stored as two bytes: high-order bit plane
+					followed by low-order bit plane.
+======================================================================*/
+void dmDisplayGrayImage(const uint8_t* image)
+{
+	uint8_t img_data;
+
+	while(!MEM_FULL(BACK->cursor)) {
+		img_data = pgm_read_byte(image++);	// read byte from flash
+		if (img_data == 0xFF) { break; }	// stop if end-of-data has been reached
+		dmPrintGray(img_data, pgm_read_byte(image++));
+	}
+}
+
+
+/*======================================================================
+	Function:		dmSetPixel
+	Input:			index of the column in display memory
+					row number (0 = top row)
+					brightness level (LEVEL_OFF .. LEVEL_FULL)
+	Output:			none
+	Description:	Set the brightness level of a single led in display memory.
+======================================================================*/
+void dmSetPixel(uint8_t pos, uint8_t row, uint8_t level)
+{
+	uint8_t mask;
+	buffer_t* buf;
+
+	pos = MEM_INDEX(pos);
+	if ((pos >= DISP_MAX) || (row >= DISP_ROWS)) { return; }
+	buf = BACK;
+	mask = 1 << row;
+	if (level & 0x02)	{ buf->memory[pos] |= mask; }
+		else			{ buf->memory[pos] &= ~mask; }
+	if (level & 0x01)	{ buf->lsb[pos] |= mask; }
+		else			{ buf->lsb[pos] &= ~mask; }
+}
+#endif
+
+
 /*======================================================================
 	Function:		dmPrintString
 	Input:			pointer to zero terminated string in flash memory
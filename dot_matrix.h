@@ -36,12 +36,38 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 #define DISP_COLUMNS		5			// number of columns (range 1..8)
 #define DISP_ROWS			7			// number of rows (range 1..8)
 #define DISP_TYPE			0			// 1 = common column anode (TA), 0 = common column cathode (TC)
+#define DISP_BLANK_SLOTS	0			// number of blank column slots per refresh cycle
+										// (0 = full brightness, 1 or more = less ghosting)
+#define DISP_SLOTS			(DISP_COLUMNS + DISP_BLANK_SLOTS)	// column slots per refresh cycle (do not change)
 //#define DISP_UPDOWN						// if defined -> display is upside down
+#define DISP_PORT_LUT						// if defined -> use lookup tables for the port outputs
+											// (much faster display refresh, needs about 400 bytes of flash)
+//#define DISP_ASM_ISR						// if defined -> use the display interrupt written in assembler
+											// (dot_matrix_isr.S, needs DISP_PORT_LUT, single buffer, no grayscale)
+//#define DISP_GRAYSCALE					// if defined -> 4 brightness levels per led using timer 1
+											// (needs DISP_MAX additional bytes of RAM)
 #define DOT_MATRIX_TYPE		Tx07-11		// choose Tx07-11 (Kingbright) or HDSP5403 (Hewlett Packard)
 //#define DOT_MATRIX_TYPE		HDSP5403
 
 // display memory
 #define DISP_MAX			200			// size of display memory in bytes (1 byte = 1 column, range 5..240)
+										// (with DISP_STREAMING: range 16..128 and a power of 2)
+#define DISP_BUFFERS		1			// number of display memories (range 1..2)
+										// 2 = double buffering: new content is rendered in the background and
+										// shown at the start of a refresh cycle (no torn frames).
+										// RAM usage is DISP_BUFFERS * DISP_MAX, so reduce DISP_MAX (e. g. to 120).
+//#define DISP_STREAMING					// if defined -> messages are rendered on the fly while scrolling
+										// (no length limit, DISP_MAX may be small, e. g. 32; forward scrolling only)
+//#define DISP_MARQUEE						// if defined -> the display content is scrolled endlessly as a ring
+										// (no restart jump at the end, no bidirectional scrolling)
+#define DISP_MARQUEE_GAP	6			// number of blank columns between end and beginning of the content
+										// in marquee mode (only for scrolling increment 1, range 0..15)
+
+// brightness levels of a led in grayscale mode
+#define LEVEL_OFF			0
+#define LEVEL_LOW			1			// 1/3 of full brightness
+#define LEVEL_MEDIUM		2			// 2/3 of full brightness
+#define LEVEL_FULL			3
 
 // scrolling directions
 #define FORWARD				0			// text moves from right to left
@@ -123,22 +149,63 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 #endif
 
 
+// streaming mode
+#ifdef DISP_STREAMING
+	#if (DISP_MAX & (DISP_MAX - 1)) || (DISP_MAX > 128) || (DISP_BUFFERS > 1)
+		#error "DISP_STREAMING needs DISP_MAX = 16, 32, 64 or 128 and DISP_BUFFERS = 1"
+	#endif
+#endif
+
+// marquee mode
+#ifdef DISP_MARQUEE
+	#if defined(DISP_STREAMING) || (DISP_MAX + DISP_MARQUEE_GAP > 240)
+		#error "DISP_MARQUEE needs DISP_MAX + DISP_MARQUEE_GAP <= 240 and no DISP_STREAMING"
+	#endif
+#endif
+
+// assembler display interrupt
+#ifdef DISP_ASM_ISR
+	#if !defined(DISP_PORT_LUT) || defined(DISP_GRAYSCALE) || (DISP_BUFFERS > 1) || defined(DISP_STREAMING) || defined(DISP_MARQUEE)
+		#error "DISP_ASM_ISR needs DISP_PORT_LUT, DISP_BUFFERS = 1 and none of DISP_GRAYSCALE, DISP_STREAMING, DISP_MARQUEE"
+	#endif
+	#define DISP_OFS_BASE	(DISP_MAX + 1)	// offset of display.base (checked in dot_matrix.c)
+#endif
+
+
+#ifndef __ASSEMBLER__
+
 /**************
  * prototypes *
  **************/
 void dmInit(void);
 void dmDisplay(void);
+void dmBlank(void);
+void dmStop(void);
+void dmStart(void);
 uint8_t dmScroll(void);
+uint16_t dmGetTearCount(void);
 void dmSetScrolling(uint8_t inc, uint8_t dir, uint8_t delay);
 void dmClearDisplay(void);
-void dmDisplayImage(const uint8_t* image);
+void dmShow(void);
+void dmShowFrame(const uint8_t* frame);
+uint8_t dmFree(void);
+#ifdef DISP_STREAMING
+uint8_t dmMarkEnd(void);
+#endif
 void dmPrintByte(uint8_t byt);
 void dmPrintChar(uint8_t ch);
+#ifdef DISP_GRAYSCALE
+void dmDisplayPlane(void);
+void dmPrintGray(uint8_t hi, uint8_t lo);
+void dmDisplayGrayImage(const uint8_t* image);
+void dmSetPixel(uint8_t pos, uint8_t row, uint8_t level);
+#endif
 
 // The following function was commented out to save flash memory.
 // Uncomment it if you want to use it.
 //void dmPrintString(const char* st);
 
+#endif /* __ASSEMBLER__ */
 
 
 #endif /* DOT_MATRIX_H_ */
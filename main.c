@@ -33,7 +33,8 @@ Disclaimer:			This software is provided by the copyright holder "as is" and any
 #include <avr/pgmspace.h>
 #include <avr/eeprom.h>
 #include <avr/sleep.h>
-#include <util/delay.h>
+#include <util/atomic.h>
+#include <util/crc16.h>
 #include "config.h"
 #include "dot_matrix.h"
 #include "animations.h"
@@ -57,9 +58,108 @@ FUSES =
 
 uint8_t scroll_speed = 8;					// scrolling speed (0 = fastest)
 volatile uint8_t button = PB_ACK;			// button event
-//uint8_t* msg_ptr = (uint8_t*) messages;		// pointer to next message in EEPROM
-uint8_t* msg_ptr;							// pointer to next message in EEPROM
-uint8_t* ee_write_ptr = (uint8_t*) messages;
+uint8_t msg_num = 0;						// number of the current message
+uint8_t* ee_write_ptr = (uint8_t*) messages;	// next EEPROM address written by the message upload
+#ifdef FAST_RESUME
+uint8_t disp_timsk = 0;						// display interrupts while the display is switched off (0 = display on)
+#endif
+
+// state of the message renderer
+struct {
+	uint8_t* start;							// first byte of message data in EEPROM
+	uint8_t* ptr;							// next byte of message data in EEPROM
+	const uint8_t* image;					// next byte of animation data in flash (0 = no animation)
+	uint8_t columns[DISP_COLUMNS];			// current animation frame
+	uint8_t col;							// next column of the current frame
+	uint8_t repeat;							// number of times the current frame is still rendered
+	uint8_t direct;							// 1 = direct mode
+} reader;
+
+// message bytes prefetched from EEPROM
+struct {
+	const uint8_t* adr;						// EEPROM address of data[0]
+	uint8_t count;							// number of valid bytes (0 = cache empty)
+	uint8_t data[MSG_CACHE_SIZE];
+} msg_cache;
+
+// state of the animation player
+struct {
+	const uint8_t* frame;					// current frame record in flash (0 = player stopped)
+	const uint8_t* next;					// byte following the current frame record
+	const uint8_t* start;					// first byte of the animation in flash
+	const uint8_t* loop;					// first byte of the loop range in flash
+	uint8_t columns[DISP_COLUMNS];			// current frame
+	uint8_t hold;							// number of frame times the current frame is still shown
+	uint8_t frame_time;						// duration of a frame [system timer cycles]
+	uint8_t delay;							// number of frame times to wait at the end of the loop range
+	uint8_t delay_counter;
+	uint8_t backward;						// 1 = playing backward
+	uint8_t ping_pong;						// 1 = reverse direction at both ends of the loop range
+} player;
+volatile uint8_t frame_timer = 0;			// system timer cycles until the next frame time has elapsed
+
+// software timers (see StartTimer())
+#define TIMER_STATE		0					// timeout of the sleep and wake-up transitions
+#define TIMER_COUNT		1
+struct {
+	volatile uint16_t ticks;				// system timer cycles until the timer expires
+	void (*callback)(void);					// function called when the timer has expired (0 = timer stopped)
+} timer[TIMER_COUNT];
+
+#ifdef UART_UPLOAD
+// serial receive buffer (filled by the USART receive interrupt)
+struct {
+	volatile uint8_t data[UART_RX_SIZE];
+	volatile uint8_t head;					// next write position
+	volatile uint8_t tail;					// next read position
+	volatile uint8_t overflow;				// 1 = received bytes have been lost
+	#ifdef UART_LIVE
+	volatile uint8_t flow;					// 1 = XON/XOFF flow control (live text)
+	volatile uint8_t xoff;					// 1 = XOFF has been sent
+	#endif
+} uart_rx;
+volatile uint8_t uart_timer = 0;			// system timer cycles until an incomplete frame is dropped
+
+// state of the message upload
+struct {
+	uint8_t state;							// frame parser state (see UP_SYNC etc.)
+	uint8_t cmd;							// command of the current frame
+	uint8_t len;							// number of data bytes of the current frame
+	uint8_t count;							// number of data bytes received or written
+	uint16_t crc;
+	uint8_t data[UART_BLOCK_SIZE + 1];		// frame data
+	uint8_t active;							// 1 = message data is being replaced (until the next DisplayMessage())
+} upload;
+
+#define UP_SYNC			0					// frame parser states
+#define UP_CMD			1
+#define UP_LEN			2
+#define UP_DATA			3
+#define UP_CRC_LOW		4
+#define UP_CRC_HIGH		5
+#define UP_WRITE		6					// frame data is being written to EEPROM
+#define UP_LIVE			7					// received bytes are live text
+
+#if defined(UART_LIVE) && !defined(DISP_STREAMING)
+	#error "UART_LIVE needs DISP_STREAMING"
+#endif
+#endif
+
+volatile uint16_t disp_latency = 0;			// max. latency of the display interrupt [timer 1 ticks]
+volatile uint16_t disp_overruns = 0;		// number of display interrupts that lasted into the next column
+volatile uint16_t sys_overruns = 0;			// number of missed system timer compare points
+volatile uint32_t idle_time = 0;			// time the CPU slept during the current second [timer 1 ticks]
+volatile uint8_t idle_percent = 0;			// fraction of time the CPU slept during the last second [%]
+volatile uint8_t idle_sleeping = 0;			// 1 = the CPU sleeps in IdleSleep(), the next interrupt latches the wake-up time
+uint16_t idle_wake;							// TCNT1 at the entry of the first interrupt after the wake-up
+uint8_t idle_wake_sys;						// TCNT0 at the entry of the first interrupt after the wake-up
+#ifdef FAST_RESUME
+volatile uint16_t wake_latency = 0;			// time from the wake-up interrupt to the first displayed column [timer 1 ticks]
+											// (the oscillator start-up before the interrupt comes on top, see README.md)
+#endif
+#ifdef DISP_GRAYSCALE
+volatile uint16_t plane_load = 0;			// max. delay from plane switch to end of grayscale interrupt [timer 1 ticks]
+#endif
 
 
 /**********
@@ -67,18 +167,137 @@ uint8_t* ee_write_ptr = (uint8_t*) messages;
  **********/
 
 // Usage: b=swap(a) or b=swap(b)
+#ifdef __AVR__
 #define swap(x)													\
 	({															\
 		unsigned char __x__ = (unsigned char) x;				\
 		asm volatile ("swap %0" : "=r" (__x__) : "0" (__x__));	\
 		__x__;													\
 	})
+#else
+#define swap(x)		((uint8_t)(((uint8_t)(x) << 4) | ((uint8_t)(x) >> 4)))	// (host build of the tests)
+#endif
+
+// convert milliseconds to system timer cycles (rounded up)
+#define MS_TO_TICKS(ms)	((uint16_t)(((uint32_t)(ms) * SYS_TIMER_FREQ + 999) / 1000))
+
+// 1 = live text is shown (see LiveText())
+#ifdef UART_LIVE
+#define LIVE_TEXT	(upload.state == UP_LIVE)
+#else
+#define LIVE_TEXT	0
+#endif
+
+// 1 = the message data is being uploaded, so it must not be rendered (see UploadFrame())
+#ifdef UART_UPLOAD
+#define UPLOADING	(upload.active)
+#else
+#define UPLOADING	0
+#endif
+
+// 1 = the display is switched off and frozen (see DisplayOff())
+#ifdef FAST_RESUME
+#define DISPLAY_OFF	(disp_timsk != 0)
+#else
+#define DISPLAY_OFF	0
+#endif
+
+// latch the wake-up time at the entry of an interrupt (with interrupts disabled, see IdleSleep())
+#define IDLE_WAKE()									\
+	do {											\
+		if (idle_sleeping) {						\
+			idle_wake = TCNT1;						\
+			idle_wake_sys = TCNT0;					\
+			idle_sleeping = 0;						\
+		}											\
+	} while (0)
 
 
 /*************
  * functions *
  *************/
 
+/*======================================================================
+	Function:		SetBrightness
+	Input:			brightness (0 = darkest, BRIGHTNESS_STEPS - 1 = brightest)
+	Output:			none
+	Description:	Set the on-time of the display columns.
+					Below maximum brightness each column is switched off by
+					timer 1 compare match B before the column time has elapsed.
+======================================================================*/
+void SetBrightness(uint8_t level)
+{
+	uint16_t on_time;
+
+	if (level >= BRIGHTNESS_STEPS - 1) {
+		on_time = COLUMN_TIME;
+		TIMSK1 &= ~_BV(OCIE1B);				// full on-time -> no blanking
+	}
+	else {
+		on_time = (uint32_t)(level + 1) * COLUMN_TIME / BRIGHTNESS_STEPS;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			OCR1B = on_time;
+		}
+		TIMSK1 |= _BV(OCIE1B);
+	}
+	#ifdef DISP_GRAYSCALE
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		OCR1A = on_time * 2 / 3;			// high-order bit plane for 2/3 of the on-time
+	}
+	TIMSK1 |= _BV(OCIE1A);
+	#endif
+}
+
+
+#ifdef FAST_RESUME
+/*======================================================================
+	Function:		DisplayOff
+	Input:			none
+	Output:			none
+	Description:	Switch the display off without changing its content.
+					Scrolling stops until DisplayOn() is called, so the
+					display continues where it has been switched off.
+					dmStop() applies a pending buffer swap, as no refresh
+					cycle follows until then.
+======================================================================*/
+void DisplayOff(void)
+{
+	if (DISPLAY_OFF) { return; }
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		disp_timsk = TIMSK1;
+		TIMSK1 = 0;							// stop the display interrupts
+		dmStop();
+	}
+}
+
+
+/*======================================================================
+	Function:		DisplayOn
+	Input:			none
+	Output:			none
+	Description:	Switch the display on again after DisplayOff(). A new
+					column time is started and the first column is shown at
+					once. After a wake-up from power-down the time since the
+					pin change interrupt is recorded in wake_latency.
+======================================================================*/
+void DisplayOn(void)
+{
+	if (!DISPLAY_OFF) { return; }
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (ICR1 != ICR1_CYCLE_TIME) {		// woken up (see ISR(PCINT2_vect))?
+			wake_latency = TCNT1;
+			ICR1 = ICR1_CYCLE_TIME;
+		}
+		TCNT1 = 0;
+		TIFR1 = _BV(OCF1A) | _BV(OCF1B);	// ICF1 has been set while the display was off
+		dmStart();
+		TIMSK1 = disp_timsk;				// -> the display interrupt follows right after this block
+		disp_timsk = 0;
+	}
+}
+#endif
+
+
 /*======================================================================
 	Function:		InitHardware
 	Input:			none
@@ -97,13 +316,83 @@ void InitHardware(void)
 	PORTC |= ~DISP_MASK_C;
 	PORTD |= ~DISP_MASK_D;
 	
-	// timer 0
+	// timer 0 (system timer)
 	TCCR0A = 0;				// timer mode = normal
 	TCCR0B = _BV(CS02) | _BV(CS00);					// prescaler = 1:1024
-	OCR0A = OCR0A_CYCLE_TIME;
 	OCR0B = OCR0B_CYCLE_TIME;
-	TIMSK0 = _BV(OCIE0B) | _BV(OCIE0A);
+	TIMSK0 = _BV(OCIE0B);
 	
+	// timer 1 (display columns, column on-time for brightness control and grayscale mode)
+	TCCR1A = 0;
+	TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS11);	// timer mode = CTC with TOP = ICR1, prescaler = 1:8
+	ICR1 = ICR1_CYCLE_TIME;
+	TIMSK1 = _BV(ICIE1);							// TOP reached -> next column
+	SetBrightness(BRIGHTNESS_DEFAULT);
+
+	#ifdef UART_UPLOAD
+	// USART 0 (message upload)
+	UBRR0 = UART_UBRR;
+	UCSR0A = _BV(U2X0);								// double speed mode
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);				// 8 data bits, no parity, 1 stop bit
+	UCSR0B = _BV(RXCIE0) | _BV(RXEN0) | _BV(TXEN0);
+	#endif
+}
+
+
+/*======================================================================
+	Function:		StartTimer
+	Input:			timer number (TIMER_STATE etc.)
+					duration [system timer cycles] (see MS_TO_TICKS())
+					function to be called when the timer has expired
+	Output:			none
+	Description:	Start a one-shot software timer. The timers are counted
+					down by the system timer interrupt, the callback function
+					is called from the main loop (see TimerService()), so it may
+					use the display functions. A running timer is restarted.
+======================================================================*/
+void StartTimer(uint8_t num, uint16_t ticks, void (*callback)(void))
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		timer[num].ticks = ticks;
+		timer[num].callback = callback;
+	}
+}
+
+
+/*======================================================================
+	Function:		StopTimer
+	Input:			timer number
+	Output:			none
+	Description:	Stop a software timer without calling its callback function.
+======================================================================*/
+void StopTimer(uint8_t num)
+{
+	timer[num].callback = 0;
+}
+
+
+/*======================================================================
+	Function:		TimerService
+	Input:			none
+	Output:			none
+	Description:	Call the callback functions of all expired software timers.
+					Call this function periodically, e. g. from the main loop.
+======================================================================*/
+void TimerService(void)
+{
+	void (*callback)(void);
+	uint8_t i;
+
+	for (i = 0; i < TIMER_COUNT; i++) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			callback = timer[i].callback;
+			if (timer[i].ticks) { callback = 0; }		// not expired yet
+		}
+		if (callback) {
+			timer[i].callback = 0;
+			callback();									// (may restart the timer)
+		}
+	}
 }
 
 
@@ -134,9 +423,594 @@ void SetMode(uint8_t mode)
 
 
 /*======================================================================
-	Function:		DisplayMessage
+	Function:		ReadMessageByte
+	Input:			EEPROM address
+	Output:			message byte
+	Description:	Read a byte of message data. The message data is read from
+					EEPROM in blocks of MSG_CACHE_SIZE bytes, so the message
+					renderer does not wait for the EEPROM for every byte.
+======================================================================*/
+uint8_t ReadMessageByte(const uint8_t* ee_adr)
+{
+	uint16_t ofs;
+
+	ofs = ee_adr - msg_cache.adr;
+	if (ofs >= msg_cache.count) {			// cache miss -> read next block
+		eeprom_read_block(msg_cache.data, ee_adr, MSG_CACHE_SIZE);
+		msg_cache.adr = ee_adr;
+		msg_cache.count = MSG_CACHE_SIZE;
+		ofs = 0;
+	}
+	return (msg_cache.data[ofs]);
+}
+
+
+/*======================================================================
+	Function:		SeekFrame
+	Input:			pointer to animation data in flash
+					pointer to a variable that receives the frame time
+	Output:			pointer to the next frame record (0 = end of animation reached)
+	Description:	Skip the control codes in front of a frame record. The 
+					duration given by a FRAME_TIME() code is returned in *time
+					(1 if there is none).
+======================================================================*/
+const uint8_t* SeekFrame(const uint8_t* img, uint8_t* time)
+{
+	uint8_t ch;
+
+	*time = 1;
+	while (1) {
+		ch = pgm_read_byte(img);
+		if (ch == END_OF_DATA) { return (0); }
+		if (IS_FRAME_TIME(ch)) {
+			if (ch & 0x3F) { *time = ch & 0x3F; }
+		}
+		else if (ch != LOOP_START) {
+			return (img);
+		}
+		img++;
+	}
+}
+
+
+/*======================================================================
+	Function:		DecodeFrame
+	Input:			pointer to a frame record in flash
+					frame buffer (DISP_COLUMNS bytes, holds the previous frame)
+					pointer to a variable that receives the repeat count
+	Output:			pointer to the byte following the frame record
+	Description:	Decode a raw, delta or repeat frame record (see animations.h)
+					into the frame buffer. *repeat is set to the number of frames
+					the record stands for.
+======================================================================*/
+const uint8_t* DecodeFrame(const uint8_t* img, uint8_t* frame, uint8_t* repeat)
+{
+	uint8_t ch, i;
+
+	ch = pgm_read_byte(img);
+	*repeat = 1;
+	if (ch < 0x80) {						// raw frame
+		memcpy_P(frame, img, DISP_COLUMNS);
+		return (img + DISP_COLUMNS);
+	}
+	img++;
+	if (ch >= REPEAT_FRAME(0)) {			// repeat frame
+		*repeat = ch & 0x1F;
+	}
+	else {									// delta frame: new values of the changed columns follow
+		for (i = 0; i < DISP_COLUMNS; i++) {
+			if (ch & 0x01) { frame[i] = pgm_read_byte(img++); }
+			ch >>= 1;
+		}
+	}
+	return (img);
+}
+
+
+#ifdef MSG_UTF8
+/*======================================================================
+	Function:		DecodeUtf8
+	Input:			lead byte of a UTF-8 sequence
+	Output:			Latin-1 character code
+	Description:	Read the continuation bytes of a UTF-8 sequence from the
+					message. Characters that are not Latin-1 letters are returned 
+					as '?' (no-break space as ' '). If the following bytes do not 
+					form a UTF-8 sequence, the lead byte is returned unchanged.
+======================================================================*/
+uint8_t DecodeUtf8(uint8_t ch)
+{
+	uint8_t i, n, cont;
+
+	if (ch >= 0xF8)			{ return (ch); }	// no lead byte
+	if (ch >= 0xF0)			{ n = 3; }			// number of continuation bytes
+	else if (ch >= 0xE0)	{ n = 2; }
+	else					{ n = 1; }
+	for (i = 0; i < n; i++) {
+		if ((ReadMessageByte(reader.ptr + i) & 0xC0) != 0x80) { return (ch); }
+	}
+	cont = ReadMessageByte(reader.ptr);
+	reader.ptr += n;
+	if ((n > 1) || (ch > 0xC3)) { return ('?'); }	// beyond U+00FF
+	ch = (ch << 6) | (cont & 0x3F);
+	if (ch >= 0xC0) { return (ch); }			// Latin-1 letter
+	if (ch == 0xA0) { return (' '); }			// no-break space
+	return ('?');
+}
+#endif
+
+
+/*======================================================================
+	Function:		RenderMessage
+	Input:			none
+	Output:			0 = end of message has been reached, 1 = otherwise
+	Description:	Render the next part of the current message (i. e. one character
+					or one column of animation or direct mode data) to the display 
+					memory. See DisplayMessage() for the escape characters.
+======================================================================*/
+uint8_t RenderMessage(void)
+{
+	uint8_t ch;
+
+	if (reader.image) {						// animation
+		if (reader.col >= DISP_COLUMNS) {	// current frame completely rendered?
+			reader.col = 0;
+			if (--reader.repeat == 0) {
+				reader.image = SeekFrame(reader.image, &ch);	// (frame time is ignored here)
+				if (reader.image) {
+					reader.image = DecodeFrame(reader.image, reader.columns, &reader.repeat);
+				}
+			}
+		}
+		if (reader.image) {
+			dmPrintByte(reader.columns[reader.col++]);
+			return (1);
+		}
+	}
+	else if (reader.direct) {				// direct mode
+		ch = ReadMessageByte(reader.ptr++);
+		if (ch != 0xFF) {
+			dmPrintByte(ch);
+			return (1);
+		}
+		reader.direct = 0;
+	}
+	else {
+		ch = ReadMessageByte(reader.ptr);
+		if (ch == 0) { return (0); }		// end of message
+		reader.ptr++;
+		if (ch == '~') {					// animation
+			ch = ReadMessageByte(reader.ptr++);
+			if (ch != '~') {
+				ch -= 'A';
+				if (ch < ANIMATION_COUNT) {
+					reader.image = (const uint8_t*)pgm_read_word(&animation[ch]);
+					reader.col = DISP_COLUMNS;
+					reader.repeat = 1;
+					return (1);
+				}
+			}
+		}
+		else if (ch == 0xFF) {				// direct mode
+			reader.direct = 1;
+			return (1);
+		}
+		else {								// character
+			if (ch == '^') {				// special character
+				ch = ReadMessageByte(reader.ptr++);
+				if (ch != '^') {
+					ch += 63;
+				}
+			}
+			#ifdef MSG_UTF8
+			else if (ch >= 0xC0) {			// lead byte of a UTF-8 sequence
+				ch = DecodeUtf8(ch);
+			}
+			#endif
+			dmPrintChar(ch);
+		}
+	}
+	if (ReadMessageByte(reader.ptr)) { dmPrintByte(0); }	// print a narrow space except for the last character
+	return (1);
+}
+
+
+/*======================================================================
+	Function:		SkipMessage
 	Input:			pointer to zero terminated message data in EEPROM memory
-	Output:			pointer to next message
+	Output:			pointer to the byte following the message
+	Description:	Find the end of a message without rendering it.
+					A result beyond messages[] means that the message is not
+					terminated.
+======================================================================*/
+uint8_t* SkipMessage(uint8_t* ee_adr)
+{
+	const uint8_t* end = messages + MSG_SIZE;
+	uint8_t ch;
+
+	ch = ReadMessageByte(ee_adr++);
+	while (ch && (ee_adr < end)) {			// (stop at the end of the message area)
+		if ((ch == '~') || (ch == '^')) {	// escape character -> skip next byte
+			ee_adr++;
+		}
+		else if (ch == 0xFF) {				// direct mode -> skip data
+			while ((ee_adr < end) && (ReadMessageByte(ee_adr++) != 0xFF)) {}
+		}
+		ch = ReadMessageByte(ee_adr++);
+	}
+	return (ee_adr);
+}
+
+
+/*======================================================================
+	Function:		EepromReady
+	Input:			none
+	Output:			1 = an EEPROM write can be started now, 0 = otherwise
+	Description:	Check that the EEPROM is ready and that the current column
+					time leaves at least 20 us until the next display interrupt
+					(see EEPROM_WRITE_WINDOW), so the short interrupt lock at the
+					start of a write never delays the display.
+======================================================================*/
+uint8_t EepromReady(void)
+{
+	uint16_t time;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		time = TCNT1;						// (16 bit read, TEMP is shared with the display interrupt)
+	}
+	return (eeprom_is_ready() && (time <= EEPROM_WRITE_WINDOW));
+}
+
+
+/*======================================================================
+	Function:		EepromUpdate
+	Input:			EEPROM address
+					value
+	Output:			none
+	Description:	Write a byte to EEPROM unless it already has this value.
+					Waits until a write can be started (see EepromReady()).
+======================================================================*/
+void EepromUpdate(uint8_t* adr, uint8_t value)
+{
+	if (eeprom_read_byte(adr) == value) { return; }
+	while (!EepromReady()) {}
+	eeprom_update_byte(adr, value);
+}
+
+
+/*======================================================================
+	Function:		CheckDirectory
+	Input:			none
+	Output:			1 = message directory is valid, 0 = otherwise
+	Description:	Check the message directory against its checksum and the
+					message data: every offset has to point to a non-zero mode
+					byte that follows the terminating zero of the previous
+					message, the end offset to the final zero mode byte.
+					Only two bytes per message are read, the messages are not 
+					scanned.
+======================================================================*/
+uint8_t CheckDirectory(void)
+{
+	uint8_t count, i, ofs, prev, sum;
+
+	count = eeprom_read_byte(&msg_dir.count);
+	if (count > MSG_MAX) { return (0); }
+	sum = count + eeprom_read_byte(&msg_dir.check);
+	prev = 0;
+	for (i = 0; i <= count; i++) {
+		ofs = eeprom_read_byte(&msg_dir.offset[i]);
+		sum += ofs;
+		if (i == 0) {
+			if (ofs != 0) { return (0); }
+		}
+		else {
+			if (ofs <= prev) { return (0); }
+			if (eeprom_read_byte(&messages[ofs - 1]) != 0) { return (0); }	// end of previous message
+		}
+		if ((eeprom_read_byte(&messages[ofs]) == 0) != (i == count)) { return (0); }	// mode byte
+		prev = ofs;
+	}
+	return (sum == 0);
+}
+
+
+/*======================================================================
+	Function:		BuildDirectory
+	Input:			none
+	Output:			none
+	Description:	Scan the message data and write the message directory.
+					If the message list does not end within messages[] or if 
+					there are more than MSG_MAX messages, the list is cut off 
+					by writing a zero mode byte.
+					Only changed bytes are written, see EepromUpdate().
+======================================================================*/
+void BuildDirectory(void)
+{
+	uint8_t* ee_adr;
+	uint8_t count, sum;
+
+	ee_adr = (uint8_t*) messages;
+	count = 0;
+	sum = 0;
+	while (ReadMessageByte(ee_adr)) {
+		if (count == MSG_MAX) {									// too many messages
+			EepromUpdate(ee_adr, 0);
+			break;
+		}
+		EepromUpdate(&msg_dir.offset[count], ee_adr - messages);
+		sum += ee_adr - messages;
+		count++;
+		ee_adr = SkipMessage(ee_adr + 1);
+		if (ee_adr >= (uint8_t*) messages + MSG_SIZE) {			// no end of list
+			count--;
+			sum -= eeprom_read_byte(&msg_dir.offset[count]);
+			ee_adr = (uint8_t*) messages + eeprom_read_byte(&msg_dir.offset[count]);
+			EepromUpdate(ee_adr, 0);
+			break;
+		}
+	}
+	msg_cache.count = 0;							// message data may have changed
+	EepromUpdate(&msg_dir.offset[count], ee_adr - messages);	// end of list
+	sum += ee_adr - messages;
+	EepromUpdate(&msg_dir.count, count);
+	EepromUpdate(&msg_dir.check, -(uint8_t)(sum + count));
+}
+
+
+/*======================================================================
+	Function:		MessageAddress
+	Input:			message number
+	Output:			EEPROM address of the message (mode byte)
+	Description:	Look up a message in the message directory. For an invalid
+					message number the address of the end of the list is returned.
+======================================================================*/
+uint8_t* MessageAddress(uint8_t num)
+{
+	uint8_t count;
+
+	count = eeprom_read_byte(&msg_dir.count);
+	if (num > count) { num = count; }
+	return ((uint8_t*) messages + eeprom_read_byte(&msg_dir.offset[num]));
+}
+
+
+/*======================================================================
+	Function:		NextMessage
+	Input:			message number
+	Output:			number of the following message
+	Description:	Step to the next message, restart after the last one.
+======================================================================*/
+uint8_t NextMessage(uint8_t num)
+{
+	num++;
+	if (num >= eeprom_read_byte(&msg_dir.count)) { num = 0; }
+	return (num);
+}
+
+
+/*======================================================================
+	Function:		PrevMessage
+	Input:			message number
+	Output:			number of the preceding message
+	Description:	Step to the previous message, continue with the last one
+					before the first one.
+======================================================================*/
+uint8_t PrevMessage(uint8_t num)
+{
+	uint8_t count;
+
+	count = eeprom_read_byte(&msg_dir.count);
+	if (count == 0)	{ return (0); }
+	if ((num == 0) || (num > count))	{ num = count; }
+	return (num - 1);
+}
+
+
+#ifdef DISP_STREAMING
+/*======================================================================
+	Function:		StreamMessage
+	Input:			none
+	Output:			none
+	Description:	Render the current message into the free part of the display
+					memory. When the end of the message has been reached, it is 
+					marked and the message is rendered again from the beginning.
+					Call this function periodically, e. g. from the main loop.
+======================================================================*/
+void StreamMessage(void)
+{
+	while (dmFree() > CHAR_WIDTH) {		// enough room for a character and a space?
+		if (RenderMessage() == 0) {
+			if (dmMarkEnd() == 0) { break; }	// previous end of message not displayed yet
+			reader.ptr = reader.start;		// restart from the beginning
+		}
+	}
+}
+#endif
+
+
+/*======================================================================
+	Function:		PrevFrame
+	Input:			pointer to a frame in flash
+					pointer to a variable that receives the frame time
+	Output:			pointer to the previous frame (0 = beginning of loop range reached)
+	Description:	Step back one frame record within the loop range.
+					As delta and repeat frames cannot be decoded backward, the
+					animation is decoded from its start up to the given record.
+					player.columns receives the frame in front of the previous
+					record, so that ShowFrame() decodes the previous frame.
+======================================================================*/
+const uint8_t* PrevFrame(const uint8_t* img, uint8_t* time)
+{
+	const uint8_t* rec;
+	const uint8_t* prev = 0;
+	uint8_t frame[DISP_COLUMNS], before[DISP_COLUMNS];
+	uint8_t t, repeat;
+
+	memset(frame, 0, DISP_COLUMNS);
+	rec = SeekFrame(player.start, &t);
+	while (rec && (rec != img)) {
+		if (rec >= player.loop) {			// candidate within the loop range
+			prev = rec;
+			*time = t;
+			memcpy(before, frame, DISP_COLUMNS);
+		}
+		rec = DecodeFrame(rec, frame, &repeat);
+		rec = SeekFrame(rec, &t);
+	}
+	if (prev) { memcpy(player.columns, before, DISP_COLUMNS); }
+	return (prev);
+}
+
+
+/*======================================================================
+	Function:		ShowFrame
+	Input:			pointer to a frame record in flash
+					frame time (number of frame times the frame is shown)
+	Output:			none
+	Description:	Decode a frame record and copy the frame to the display.
+======================================================================*/
+void ShowFrame(const uint8_t* img, uint8_t time)
+{
+	uint8_t repeat;
+
+	player.frame = img;
+	player.next = DecodeFrame(img, player.columns, &repeat);
+	if (repeat > 1)	{ player.hold = repeat; }
+		else		{ player.hold = time; }
+	dmShowFrame(player.columns);
+}
+
+
+/*======================================================================
+	Function:		StartAnimation
+	Input:			pointer to message data in EEPROM memory
+					mode byte of the message
+	Output:			1 = animation player started, 0 = otherwise
+	Description:	Start the animation player if the message consists of an
+					animation that is to be played frame by frame ('~' followed
+					by a lower case letter, see DisplayMessage()).
+					The speed, the delay and the reverse flag of the mode byte
+					set the frame time, the pause at the end of the loop range
+					and ping-pong playback.
+======================================================================*/
+uint8_t StartAnimation(uint8_t* ee_adr, uint8_t mode)
+{
+	const uint8_t* img;
+	const uint8_t* start;
+	uint8_t ch;
+
+	player.frame = 0;
+	if (ReadMessageByte(ee_adr++) != '~') { return (0); }
+	ch = ReadMessageByte(ee_adr) - 'a';
+	if (ch >= ANIMATION_COUNT) { return (0); }
+	dmSetScrolling(0, FORWARD, 0);			// the player takes over the display
+	player.frame_time = scroll_speed + 1;
+	player.ping_pong = (mode & 0x80) ? 1 : 0;
+	player.backward = 0;
+	player.delay = pgm_read_byte(&dly_conv[swap(mode) & 0x07]);
+	player.delay_counter = player.delay;
+
+	start = (const uint8_t*)pgm_read_word(&animation[ch]);
+	player.start = start;
+	player.loop = start;
+	img = start;
+	while ((ch = pgm_read_byte(img++)) != END_OF_DATA) {	// find the loop start
+		if (ch == LOOP_START) { player.loop = img; }
+	}
+	img = SeekFrame(start, &ch);
+	if (img) {
+		ShowFrame(img, ch);
+		frame_timer = player.frame_time;
+	}
+	return (1);
+}
+
+
+/*======================================================================
+	Function:		PlayAnimation
+	Input:			none
+	Output:			none
+	Description:	Show the next frame of the animation when the current one
+					has been shown long enough. At the end of the loop range the
+					animation continues at the loop start or, in ping-pong mode, 
+					plays backward. Frames are decoded directly from flash, so the
+					length of an animation is not limited by DISP_MAX.
+					Call this function periodically, e. g. from the main loop.
+======================================================================*/
+void PlayAnimation(void)
+{
+	const uint8_t* img;
+	uint8_t time;
+
+	if ((player.frame == 0) || frame_timer) { return; }
+	frame_timer = player.frame_time;
+	if (--player.hold) { return; }
+
+	if (player.backward)	{ img = PrevFrame(player.frame, &time); }
+		else				{ img = SeekFrame(player.next, &time); }
+	if (img == 0) {								// end of loop range reached
+		if (player.delay_counter) {
+			player.delay_counter--;
+			player.hold = 1;
+			return;
+		}
+		player.delay_counter = player.delay;
+		if (player.ping_pong) {
+			player.backward ^= 1;				// reverse direction
+			if (player.backward)	{ img = PrevFrame(player.frame, &time); }
+				else				{ img = SeekFrame(player.next, &time); }
+		}
+		else {
+			img = SeekFrame(player.loop, &time);	// restart from loop start
+		}
+		if (img == 0) {							// loop range of a single frame
+			img = player.frame;
+			time = 1;
+		}
+	}
+	ShowFrame(img, time);
+}
+
+
+#ifdef UART_UPLOAD
+/*======================================================================
+	Function:		UartSend
+	Input:			byte
+	Output:			none
+	Description:	Send a byte via the serial port.
+======================================================================*/
+void UartSend(uint8_t ch)
+{
+	loop_until_bit_is_set(UCSR0A, UDRE0);
+	UDR0 = ch;
+}
+
+
+#ifdef UART_LIVE
+/*======================================================================
+	Function:		LiveStop
+	Input:			none
+	Output:			none
+	Description:	End the live text (see LiveText()) and release the sender
+					if it has been stopped by XOFF.
+======================================================================*/
+void LiveStop(void)
+{
+	if (upload.state != UP_LIVE) { return; }
+	upload.state = UP_SYNC;
+	uart_rx.flow = 0;
+	if (uart_rx.xoff) {
+		uart_rx.xoff = 0;
+		UartSend(UART_XON);
+	}
+}
+#endif
+#endif
+
+
+/*======================================================================
+	Function:		DisplayMessage
+	Input:			message number
+	Output:			none
 	Description:	Show a message (i. e. text or animation) on the display.
 
 					Escape characters:
@@ -148,76 +1022,349 @@ void SetMode(uint8_t mode)
 
 					Character '~' followed by an upper case letter is used
 					to insert (animation) data from flash.
+					A message that starts with '~' followed by a lower case
+					letter is an animation that is played frame by frame by
+					the animation player (the rest of the message is ignored).
 					
 					The character 0xFF is used to enter direct mode in which 
 					the following bytes are directly written to the display 
 					memory without being decoded using the character font.
 					Direct mode is ended by 0xFF.
+
+					With DISP_STREAMING only the beginning of the message is 
+					rendered here, the rest follows in StreamMessage().
+					Showing a message ends the live text (UART_LIVE) and cancels
+					a pending sleep or wake-up transition (see GoToSleep()).
+					It also ends the rendering stop of an upload (see UploadFrame()).
 ======================================================================*/
-uint8_t* DisplayMessage(uint8_t* ee_adr)
+void DisplayMessage(uint8_t num)
 {
-	uint8_t ch;
+	uint8_t* ee_adr;
+	uint8_t mode;
 
-	SetMode(eeprom_read_byte(ee_adr));
-	ee_adr++;
+	#ifdef UART_LIVE
+	LiveStop();
+	#endif
+	#ifdef UART_UPLOAD
+	upload.active = 0;
+	#endif
+	StopTimer(TIMER_STATE);
+	#ifdef FAST_RESUME
+	DisplayOn();
+	#endif
+	ee_adr = MessageAddress(num);
+	mode = ReadMessageByte(ee_adr);
+	if (mode) { ee_adr++; }					// (mode 0 = empty message list -> nothing to render)
 	dmClearDisplay();
+	reader.start  = ee_adr;
+	reader.ptr    = ee_adr;
+	reader.image  = 0;
+	reader.direct = 0;
+	SetMode(mode);
+	if (StartAnimation(ee_adr, mode) == 0) {
+		#ifdef DISP_STREAMING
+		StreamMessage();
+		#else
+		while (RenderMessage()) {}
+		#endif
+	}
+	dmShow();
+}
 
-	ch = eeprom_read_byte(ee_adr++);
-	while (ch) {
-		if (ch == '~') {					// animation
-			ch = eeprom_read_byte(ee_adr++);
-			if (ch != '~') {
-				ch -= 'A';
-				if (ch < ANIMATION_COUNT) {
-					dmDisplayImage((const uint8_t*)pgm_read_word(&animation[ch]));
-				}				
-			}
+
+#ifdef UART_UPLOAD
+/*======================================================================
+	Function:		UploadFrame
+	Input:			none
+	Output:			none
+	Description:	Execute a received frame of the upload protocol (see 
+					UART_SYNC in config.h). A write frame is only checked here,
+					its data is written to EEPROM by UploadService().
+					From the first write frame on the current message is no
+					longer rendered (DISP_STREAMING), so the display never shows
+					a mix of old and new message data. UART_CMD_DONE shows the
+					first new message.
+======================================================================*/
+void UploadFrame(void)
+{
+	uint8_t ofs;
+
+	upload.state = UP_SYNC;
+	if ((upload.crc != 0) || uart_rx.overflow) {		// transmission error
+		uart_rx.overflow = 0;
+		UartSend(UART_NAK);
+	}
+	else if ((upload.cmd == UART_CMD_WRITE) && (upload.len >= 2)) {
+		ofs = upload.data[0];
+		if ((uint16_t)ofs + upload.len - 1 > MSG_SIZE) {
+			UartSend(UART_NAK);							// beyond messages[]
+			return;
 		}
-		else if (ch == 0xFF) {				// direct mode
-			ch = eeprom_read_byte(ee_adr++);
-			while (ch != 0xFF) {
-				dmPrintByte(ch);
-				ch = eeprom_read_byte(ee_adr++);
-			}
+		ee_write_ptr = (uint8_t*) messages + ofs;
+		upload.count = 1;
+		upload.state = UP_WRITE;
+		upload.active = 1;								// the message is not rendered any further
+	}
+	else if ((upload.cmd == UART_CMD_DONE) && (upload.len == 0)) {
+		BuildDirectory();
+		msg_num = 0;
+		DisplayMessage(msg_num);
+		UartSend(UART_ACK);
+	}
+	#ifdef UART_LIVE
+	else if ((upload.cmd == UART_CMD_LIVE) && (upload.len == 1)) {
+		player.frame = 0;								// stop the animation player
+		dmClearDisplay();
+		SetMode(upload.data[0]);
+		dmShow();
+		uart_rx.flow = 1;
+		upload.state = UP_LIVE;
+		UartSend(UART_ACK);
+	}
+	#endif
+	else {
+		UartSend(UART_NAK);								// unknown command
+	}
+}
+
+
+#ifdef UART_LIVE
+/*======================================================================
+	Function:		LiveText
+	Input:			none
+	Output:			none
+	Description:	Render received live text into the free part of the display
+					memory. Characters are taken from the receive buffer only as
+					fast as scrolling frees display memory, and the sender is 
+					stopped by XOFF when the buffer fills up (see USART_RX_vect),
+					so no character is lost and no further memory is needed.
+======================================================================*/
+void LiveText(void)
+{
+	uint8_t ch;
+
+	while ((uart_rx.tail != uart_rx.head) && (dmFree() > CHAR_WIDTH)) {
+		ch = uart_rx.data[uart_rx.tail];
+		uart_rx.tail = (uart_rx.tail + 1) & (UART_RX_SIZE - 1);
+		if (ch == UART_EOT) {
+			DisplayMessage(msg_num);					// (ends the live text)
+			return;
 		}
-		else {								// character
-			if (ch == '^') {				// special character
-				ch = eeprom_read_byte(ee_adr++);
-				if (ch != '^') {
-					ch += 63;
-				}
-			}
+		if (ch == '\n')	{ ch = 0x9D; }				// long space
+		if (ch >= ' ') {
 			dmPrintChar(ch);
+			dmPrintByte(0);								// narrow space
 		}
-		ch = eeprom_read_byte(ee_adr++);
-		if (ch) { dmPrintByte(0); }			// print a narrow space except for the last character					
 	}
-	ch = eeprom_read_byte(ee_adr);			// read mode byte of next message
-	if (ch)		{ return(ee_adr); }
-		else	{ return((uint8_t*) messages); }	// restart all-over if mode byte is 0
+	if (uart_rx.xoff && (((uart_rx.head - uart_rx.tail) & (UART_RX_SIZE - 1)) <= UART_XON_LEVEL)) {
+		uart_rx.xoff = 0;
+		UartSend(UART_XON);								// release the sender
+	}
 }
+#endif
 
 
 /*======================================================================
-	Function:		GoToSleep
+	Function:		UploadService
 	Input:			none
 	Output:			none
-	Description:	Put the controller into sleep mode and prepare for
-					wake-up by a pin change interrupt.
+	Description:	Receive frames of the upload protocol and write the uploaded
+					message data to EEPROM while the display keeps running.
+					The EEPROM is written byte by byte without waiting for the
+					end of a write cycle (3.4 ms), and a write is only started
+					while at least 20 us of the column time remain (see
+					EepromReady()). The message directory is rebuilt the same
+					way after UART_CMD_DONE, but within one call.
+					A write frame is acknowledged when its data has been written,
+					so the sender never overruns the receive buffer.
+					Call this function periodically, e. g. from the main loop.
 ======================================================================*/
-void GoToSleep(void)
+void UploadService(void)
+{
+	uint8_t ch;
+
+	#ifdef UART_LIVE
+	if (upload.state == UP_LIVE) {
+		LiveText();
+		return;
+	}
+	#endif
+	if (upload.state == UP_WRITE) {
+		if (!EepromReady()) { return; }
+		eeprom_update_byte(ee_write_ptr++, upload.data[upload.count++]);
+		if (upload.count >= upload.len) {				// frame completely written
+			msg_cache.count = 0;						// message data has changed
+			upload.state = UP_SYNC;
+			UartSend(UART_ACK);
+		}
+		return;
+	}
+
+	if ((upload.state != UP_SYNC) && (uart_timer == 0)) {	// incomplete frame
+		upload.state = UP_SYNC;
+	}
+	while (uart_rx.tail != uart_rx.head) {
+		ch = uart_rx.data[uart_rx.tail];
+		uart_rx.tail = (uart_rx.tail + 1) & (UART_RX_SIZE - 1);
+		upload.crc = _crc_ccitt_update(upload.crc, ch);	// (the CRC over a complete frame is 0)
+		switch (upload.state) {
+			case UP_SYNC:
+				if (ch == UART_SYNC) {
+					upload.crc = 0xFFFF;
+					upload.state = UP_CMD;
+				}
+				break;
+			case UP_CMD:
+				upload.cmd = ch;
+				upload.state = UP_LEN;
+				break;
+			case UP_LEN:
+				upload.len = ch;
+				upload.count = 0;
+				if (ch > sizeof(upload.data))	{ upload.state = UP_SYNC; UartSend(UART_NAK); }
+					else if (ch)				{ upload.state = UP_DATA; }
+					else						{ upload.state = UP_CRC_LOW; }
+				break;
+			case UP_DATA:
+				upload.data[upload.count++] = ch;
+				if (upload.count == upload.len) { upload.state = UP_CRC_LOW; }
+				break;
+			case UP_CRC_LOW:
+				upload.state = UP_CRC_HIGH;
+				break;
+			case UP_CRC_HIGH:
+				UploadFrame();
+				if (upload.state != UP_SYNC) { return; }	// remaining bytes are handled in the next call
+				break;
+		}
+	}
+}
+#endif
+
+
+/*======================================================================
+	Function:		IdleSleep
+	Input:			none
+	Output:			none
+	Description:	Let the CPU sleep until the next interrupt, i. e. at the
+					latest until the next display column. The timers and the
+					USART keep running in idle mode. The time spent sleeping is
+					added to idle_time, from which the system timer interrupt
+					computes idle_percent once a second.
+					While the display is switched off (FAST_RESUME) no display
+					interrupt ends the sleep, so it may last up to a system
+					timer cycle and span many timer 1 periods. The sleep is
+					then measured with timer 0 instead (resolution 64 us).
+					The sleep ends at the entry of the first interrupt (see
+					IDLE_WAKE()), so the time the interrupts take before
+					this function continues is not counted as idle time.
+					The assembler display interrupt (DISP_ASM_ISR) latches
+					nothing: if the sleep ends without a latch in a new 
+					column, the display interrupt has ended it at the start
+					of the column.
+======================================================================*/
+void IdleSleep(void)
+{
+	uint16_t start, time;
+	uint8_t start_sys, time_sys;
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	cli();
+	start = TCNT1;
+	start_sys = TCNT0;
+	idle_sleeping = 1;
+	sleep_enable();
+	sei();									// (the next instruction is executed before any interrupt)
+	sleep_cpu();
+	sleep_disable();
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (idle_sleeping) {				// no interrupt has latched the wake-up time
+			idle_sleeping = 0;
+			idle_wake = TCNT1;
+			idle_wake_sys = TCNT0;
+			#ifdef DISP_ASM_ISR
+			if (!DISPLAY_OFF && (idle_wake < start)) { idle_wake = 0; }
+			#endif
+		}
+		time = idle_wake;
+		time_sys = idle_wake_sys;
+	}
+	if (DISPLAY_OFF) {							// (only changed by the main loop, i. e. not while sleeping)
+		time = (uint8_t)(time_sys - start_sys) * (1024 / 8);	// timer 0 ticks -> timer 1 ticks
+	}
+	else {
+		if (time < start) { time += COLUMN_TIME; }	// timer 1 has restarted at the next column
+		time -= start;
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		idle_time += time;
+	}
+}
+
+
+/*======================================================================
+	Function:		ShowCurrentMessage
+	Input:			none
+	Output:			none
+	Description:	Show the current message (callback of TIMER_STATE at the 
+					end of the wake-up transition).
+======================================================================*/
+void ShowCurrentMessage(void)
+{
+	DisplayMessage(msg_num);
+}
+
+
+/*======================================================================
+	Function:		PowerDown
+	Input:			none
+	Output:			none
+	Description:	Put the controller into power-down mode until a pin change
+					interrupt wakes it up, then show a smiley for 500 ms before
+					the first message (callback of TIMER_STATE).
+					With FAST_RESUME the display continues the message that
+					was shown when it has been put to sleep (the whole state
+					is kept in SRAM during power-down).
+======================================================================*/
+void PowerDown(void)
 {
-	dmClearDisplay();
-	_delay_ms(1000);
 	PCIFR |= _BV(PCIF2);				// clear interrupt flag
 	PCMSK2 = _BV(PCINT16);			// enable pin change interrupt
 	PCICR  = _BV(PCIE2);
 	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
 	sleep_mode();
 	PCICR = 0;
+	button = PB_LONGPRESS | PB_ACK;		// (releasing the button that woke us up is no short press)
+	#ifdef FAST_RESUME
+	DisplayOn();
+	#else
+	dmClearDisplay();
 	dmPrintChar(131);				// happy smiley
-	_delay_ms(500);
-	msg_ptr = DisplayMessage((uint8_t*) messages);
+	dmShow();
+	msg_num = 0;
+	StartTimer(TIMER_STATE, MS_TO_TICKS(500), ShowCurrentMessage);
+	#endif
+}
+
+
+/*======================================================================
+	Function:		GoToSleep
+	Input:			none
+	Output:			none
+	Description:	Clear the display and put the controller into sleep mode 
+					after one second (see PowerDown()). The transition does not
+					block the main loop and is cancelled by showing a message.
+					With FAST_RESUME the display is only switched off.
+======================================================================*/
+void GoToSleep(void)
+{
+	#ifdef FAST_RESUME
+	DisplayOff();
+	#else
+	dmClearDisplay();
+	dmShow();
+	#endif
+	StartTimer(TIMER_STATE, MS_TO_TICKS(1000), PowerDown);
 }
 
 
@@ -233,25 +1380,62 @@ int main(void)
 
 	ADCSRA = 0;
 
+	if (CheckDirectory() == 0) {			// message data changed since the directory was built?
+		BuildDirectory();
+	}
+
+	#ifdef FAST_RESUME
+	DisplayMessage(msg_num);				// (shown when the display wakes up)
+	#endif
 	GoToSleep();
-	dmPrintChar(131);				// happy smiley
 	button |= PB_ACK;
 
 	while(1)
 	{
+		TimerService();						// sleep and wake-up transitions
+		#ifdef UART_UPLOAD
+		UploadService();					// receive uploaded messages
+		#endif
+		if (timer[TIMER_STATE].callback == 0) {	// (the display is not used by a transition)
+			PlayAnimation();				// show the next animation frame when it is due
+			#ifdef DISP_STREAMING
+			if ((player.frame == 0) && !LIVE_TEXT && !UPLOADING) {
+				StreamMessage();			// render more columns while the display scrolls
+			}
+			#endif
+		}
+
 		if (button == PB_RELEASE) {			// short button press
-			msg_ptr = DisplayMessage(msg_ptr);
+			msg_num = NextMessage(msg_num);
+			DisplayMessage(msg_num);
+			button |= PB_ACK;
+		}
+
+		if (button == PB_DOUBLE) {			// short double press
+			msg_num = PrevMessage(PrevMessage(msg_num));	// (the first press has already stepped forward)
+			DisplayMessage(msg_num);
 			button |= PB_ACK;
 		}
 		
 		if (button == PB_LONGPRESS) {		// button pressed for some seconds
+			#ifdef FAST_RESUME
+			if (LIVE_TEXT) {
+				DisplayMessage(msg_num);	// (live text cannot be continued after the wake-up)
+			}
+			GoToSleep();
+			#else
+			#ifdef UART_LIVE
+			LiveStop();
+			#endif
 			dmClearDisplay();
 			dmPrintChar(130);				// sad smiley
-			_delay_ms(500);
-			GoToSleep();
+			dmShow();
+			StartTimer(TIMER_STATE, MS_TO_TICKS(500), GoToSleep);
+			#endif
 			button |= PB_ACK;
 		}
-		
+
+		IdleSleep();						// wait for the next interrupt
 	} // of while(1)
 }
 
@@ -260,48 +1444,133 @@ int main(void)
  * interrupt service routines *
  ******************************/
 
-ISR(TIMER0_COMPA_vect)
-// display interrupt
+#ifndef DISP_ASM_ISR
+ISR(TIMER1_CAPT_vect)
+// display interrupt (see dot_matrix_isr.S for the assembler version)
 {
-	OCR0A += OCR0A_CYCLE_TIME;				// setup next cycle
+	uint16_t temp;
+
+	IDLE_WAKE();
+	temp = TCNT1;							// timer 1 restarts at TOP -> TCNT1 = interrupt latency
+	if (temp > disp_latency) { disp_latency = temp; }
 
 	dmDisplay();							// show next column on dot matrix display
+
+	if (TIFR1 & _BV(ICF1)) {				// next column already due?
+		disp_overruns++;
+	}
+}
+#endif
+
+
+ISR(TIMER1_COMPB_vect)
+// brightness interrupt (end of column on-time)
+{
+	IDLE_WAKE();
+	dmBlank();
+}
+
+
+#ifdef DISP_GRAYSCALE
+ISR(TIMER1_COMPA_vect)
+// grayscale interrupt (switch to low-order bit plane)
+{
+	uint16_t temp;
+
+	IDLE_WAKE();
+	dmDisplayPlane();
+	temp = TCNT1 - OCR1A;					// measure interrupt latency + run time
+	if (temp > plane_load) { plane_load = temp; }
 }
+#endif
 
 
-ISR(TIMER0_COMPB_vect)
+ISR(TIMER0_COMPB_vect, ISR_NOBLOCK)
 // system timer interrupt
+// Interrupts are enabled during the system timer interrupt, so the display
+// interrupts are never delayed by it (see disp_latency).
 {
 	static uint8_t scroll_timer = 1;
+	static uint8_t stat_timer = SYS_TIMER_FREQ;	// system timer cycles until the end of the current second
 	static uint8_t pb_timer = 0;			// push button timer
+	static uint8_t pb_count = 0;			// number of successive samples with the button pressed
+	static uint8_t pb_gap = 0;				// system timer cycles within which a press is a double press
 	uint8_t temp;
 		
-	OCR0B += OCR0B_CYCLE_TIME;				// setup next cycle
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		IDLE_WAKE();						// (a nested display interrupt may have done it already)
+		OCR0B += OCR0B_CYCLE_TIME;			// setup next cycle
+		temp = OCR0B - TCNT0;				// timer ticks until next cycle
+		if (temp > OCR0B_CYCLE_TIME) {		// next compare point already passed?
+			OCR0B = TCNT0 + 1;				// -> resynchronize (otherwise the next cycle would
+			sys_overruns++;					//    follow a complete timer period later)
+		}
+	}
 
 
+	if (frame_timer) {
+		frame_timer--;
+	}
+
+	for (temp = 0; temp < TIMER_COUNT; temp++) {	// software timers
+		if (timer[temp].ticks) {
+			timer[temp].ticks--;
+		}
+	}
+
+	if (--stat_timer == 0) {				// idle time statistics of the last second
+		stat_timer = SYS_TIMER_FREQ;
+		idle_percent = idle_time / (F_CPU / 8 / 100);
+		idle_time = 0;
+	}
+
+	#ifdef UART_UPLOAD
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {		// (the receive interrupt restarts the timer)
+		if (uart_timer) {
+			uart_timer--;
+		}
+	}
+	#endif
+
 	if (scroll_timer) {
 		scroll_timer--;
 	}
-	else {
+	else if (!DISPLAY_OFF) {				// (the display is frozen while it is switched off)
 		scroll_timer = scroll_speed;		// restart timer
-		dmScroll();							// do a scrolling step
+		dmScroll();							// do a scrolling step (the display interrupts may interrupt it)
 	}
 	
 	// push button sampling
 	temp = ~PB_PIN;							// sample push button
 	temp &= PB_MASK;						// extract push button state
+	#ifdef UART_UPLOAD
+	if (uart_timer) {						// serial data on the shared pin
+		temp = 0;							// -> low levels are start and data bits
+	}
+	#endif
 	if (temp == 0) {						// --- button not pressed ---
+		pb_count = 0;
+		if (pb_gap) {
+			pb_gap--;
+		}
 		if (button & PB_PRESS) {			// former state = pressed?
+			if ((button & (PB_LONG | PB_DOUBLE)) == 0) {	// short single press?
+				pb_gap = PB_DOUBLE_DELAY;	// -> the next press may be a double press
+			}
 			button &= ~(PB_PRESS | PB_ACK);	// -> issue release event
 		}
 	}
 	else {									// --- button pressed ---
 		if ((button & PB_PRESS) == 0) {		// former state = button released?
-			button = PB_PRESS;				// issue new press event
-			pb_timer = PB_LONGPRESS_DELAY;	// start push button timer
+			if (++pb_count >= PB_DEBOUNCE) {	// pressed long enough (longer than a character on RXD)?
+				if (pb_gap)	{ button = PB_PRESS | PB_DOUBLE; }	// issue new press event
+					else	{ button = PB_PRESS; }
+				pb_gap = 0;
+				pb_timer = PB_LONGPRESS_DELAY;	// start push button timer
+			}
 		}
 		else {
-			if (button == PB_PRESS) {		// holding key pressed
+			if ((button & ~PB_DOUBLE) == PB_PRESS) {	// holding key pressed
 				if (pb_timer == 0) {		// if push button timer has elapsed
 					button = PB_LONGPRESS;	// issue long event
 				}
@@ -311,13 +1580,50 @@ ISR(TIMER0_COMPB_vect)
 			}			
 		}		
 	}
-	
 }
 
 
+#ifdef UART_UPLOAD
+ISR(USART_RX_vect)
+// serial receive interrupt
+// RXD is shared with the push button (see UART_UPLOAD in config.h).
+{
+	uint8_t status, ch, head;
+
+	IDLE_WAKE();
+	status = UCSR0A;
+	ch = UDR0;
+	if (status & _BV(FE0)) { return; }		// break (push button pressed) or contact bounce
+	head = (uart_rx.head + 1) & (UART_RX_SIZE - 1);
+	if (head == uart_rx.tail) {				// buffer full -> byte is lost
+		uart_rx.overflow = 1;
+	}
+	else {
+		uart_rx.data[uart_rx.head] = ch;
+		uart_rx.head = head;
+	}
+	#ifdef UART_LIVE
+	if (uart_rx.flow && !uart_rx.xoff && (((head - uart_rx.tail) & (UART_RX_SIZE - 1)) >= UART_XOFF_LEVEL)) {
+		if (UCSR0A & _BV(UDRE0)) {			// (otherwise try again with the next byte)
+			UDR0 = UART_XOFF;				// stop the sender
+			uart_rx.xoff = 1;
+		}
+	}
+	#endif
+	uart_timer = UART_TIMEOUT;
+}
+#endif
+
+
 ISR(PCINT2_vect)
 // pin change interrupt (for wake-up)
 {
+	#ifdef FAST_RESUME
+	if (DISPLAY_OFF) {						// measure the wake-up latency (see DisplayOn())
+		ICR1 = 0xFFFF;						// (timer 1 counts up to 32 ms without restarting)
+		TCNT1 = 0;
+	}
+	#endif
 }
 
 
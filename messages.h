@@ -0,0 +1,45 @@
+// Default message data and message directory
+// Generated by tools/msgcompile.py from messages.txt, do not edit.
+
+const uint8_t messages[MSG_SIZE] EEMEM = {
+	0x53, ' ', 'H', 'a', 'c', 'k', ' ', 'y', 'o', 'u', 'r', ' ', 's', 'c', 'h', 'o', 'o', 'l', 0x9D, 0x00,	// Hack your school
+	0x53, ' ', 'T', 'e', 'l', 'e', 'o', '-', 'c', 0x9D, 0x00,	// Teleo-c
+	0x64, ' ', 'I', ' ', '^', 'R', ' ', 'C', 'h', 'a', 'o', 's', 'd', 'o', 'r', 'f', 0x9D, 0x00,	// I Chaosdorf
+	0xC4, 0x8B, ' ', 0x8C, ' ', 0x8E, ' ', 0x8D, 0x00,	// Monster
+	0x0B, 0xA3, ' ', 0xA5, ' ', 0xA6, ' ', 0xA0, ' ', 0x00,	// break-dance
+	0x04, ' ', '^', 'S', '^', 'S', '^', 'S', 0x9D, 0x00,	// turn left
+	0x04, ' ', 0x94, 0x95, 0x95, ' ', 0x94, ' ', 0x95, 0x7F, 0x94, 0x9D, 0x00,	// music
+	0x95, ' ', '|', ' ', 0x00,	// scan
+	0x6C, '~', 'a', 0x00,	// arrow
+	0x0D, '~', 'b', 0x00,	// fire
+	0x4B, '~', 'C', 0x9D, 0x00,	// bounce
+	0x84, '~', 'D', 0x00,	// creeper
+	0x4A, '~', 'e', 0x00,	// snow
+	0x3D, '~', 'F', 0x9D, 0x00,	// tunnel
+	0x5A, '~', 'g', 0x00,	// wink
+	0x34, '~', 'H', 0x00,	// ecg
+	0x0E, '~', 'i', 0x00,	// crazy checkers
+	0x4A, 0x91, ' ', 0x91, 0x9D, 0x00,	// heartbeat
+	0x49, '~', 'j', 0x00,	// tetris
+	0x5B, '~', 'k', 0x00,	// glider
+	0x8B, '~', 'L', 0x9D, 0x00,	// hop
+	0x6B, '~', 'm', 0x00,	// pong
+	0x38, ' ', 0x9D, '~', 'N', 0x00,	// house
+	0x6B, '~', 'O', 0x9D, 0x00,	// rocket
+	0x64, 0x9D, '~', 'P', 0x9D, 0x00,	// train
+	0x5B, '3', '3', 0x7F, ' ', '2', '2', 0x7F, ' ', 0x7F, '1', 0x7F, '1', '~', 'Q', 0x9D, 0x00,	// explode
+	0x6C, '~', 'r', 0x00,	// droplet
+	0x0E, '~', 's', 0x00,	// psycho
+	0x7D, '~', 'T', 0x9D, 0x00,	// TV off
+	0x0D, '~', 'u', 0x00,	// clock
+	0x00
+};
+
+msg_dir_t msg_dir EEMEM = {
+	30,
+	{
+		0, 20, 31, 49, 58, 68, 78, 91, 96, 100, 104, 109, 113, 117, 122, 126,
+		130, 134, 140, 144, 148, 153, 157, 163, 168, 174, 191, 195, 199, 204, 208,
+	},
+	0x14
+};
@@ -0,0 +1,302 @@
+/*
+ * display_test.c
+ *
+ * Host test of the display driver (dot_matrix.c) and of its use by the
+ * firmware (main.c), both are part of this file. Built and run by
+ * display_test.py.
+ *
+ * Usage:	display_test <case>
+ *			pingpong	ping-pong playback of all animations (packed frame records)
+ *			idle	idle time measurement, the interrupts after the wake-up are busy time
+ *			swap	buffer swaps while the display is stopped (DISP_BUFFERS = 2)
+ *			sleep	switching the display off and on with a pending buffer swap
+ *					(DISP_BUFFERS = 2, FAST_RESUME)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "sim.h"
+
+#include "dot_matrix.c"
+#undef swap
+#define main firmware_main
+#include "main.c"
+#undef main
+
+
+/***********
+ * helpers *
+ ***********/
+
+#define TIMEOUT		5						// [s] a test case that takes longer hangs
+
+static int failures = 0;
+
+#define CHECK(cond, ...)										\
+	do {														\
+		if (!(cond)) {											\
+			printf("FAIL %s:%d: ", __FILE__, __LINE__);			\
+			printf(__VA_ARGS__);								\
+			printf("\n");										\
+			failures++;											\
+		}														\
+	} while (0)
+
+static void Hang(int sig)
+{
+	(void) sig;
+	printf("FAIL: no progress for %d s (hangs)\n", TIMEOUT);
+	fflush(stdout);
+	_exit(1);
+}
+
+// write DISP_COLUMNS columns of the value to the back buffer and show them
+static void ShowPattern(uint8_t value)
+{
+	uint8_t i;
+
+	dmClearDisplay();
+	for (i = 0; i < DISP_COLUMNS; i++) { dmPrintByte(value); }
+	dmShow();
+}
+
+#if DISP_BUFFERS > 1
+// 1 = the front buffer holds DISP_COLUMNS columns of the value
+static int FrontIs(uint8_t value)
+{
+	uint8_t i;
+
+	if (FRONT->cursor != DISP_COLUMNS) { return (0); }
+	for (i = 0; i < DISP_COLUMNS; i++) {
+		if (FRONT->memory[i] != value) { return (0); }
+	}
+	return (1);
+}
+#endif
+
+
+// complete a pending buffer swap, 1 = the front buffer holds the frame
+static int FrontHolds(const uint8_t* frame)
+{
+	#if DISP_BUFFERS > 1
+	uint8_t i;
+
+	for (i = 0; (i < DISP_SLOTS) && display.swap; i++) { TIMER1_CAPT_vect(); }
+	#endif
+	return ((FRONT->cursor == DISP_COLUMNS) && (memcmp(FRONT->memory, frame, DISP_COLUMNS) == 0));
+}
+
+
+/**************
+ * test cases *
+ **************/
+
+#define WAKE_TIME	5						// timer ticks from the wake-up to the interrupt entry
+#define BUSY_TIME	40						// timer ticks the interrupts take after the wake-up
+
+// sleep ended by the display interrupt at the start of the next column
+static void WakeByDisplay(void)
+{
+	TCNT1 = WAKE_TIME;
+	TIMER1_CAPT_vect();
+	TCNT1 += BUSY_TIME;
+}
+
+#ifdef FAST_RESUME
+// sleep ended by the system timer interrupt while the display is off
+static void WakeBySystemTimer(void)
+{
+	TCNT0 += WAKE_TIME;
+	PIND = 0xFF;							// (push button released)
+	TIMER0_COMPB_vect();
+	TCNT0 += BUSY_TIME;
+}
+#endif
+
+// idle time of sleeps that end with an interrupt
+static void TestIdle(void)
+{
+	uint32_t expected;
+
+	InitHardware();
+	dmInit();
+	ShowPattern(0x55);
+
+	idle_time = 0;
+	TCNT1 = COLUMN_TIME - 300;
+	sim_sleep_hook = WakeByDisplay;
+	IdleSleep();
+	expected = 300 + WAKE_TIME;
+	CHECK(idle_time == expected, "display on: idle time %u, expected %u",
+		  (unsigned) idle_time, (unsigned) expected);
+	CHECK(!idle_sleeping, "wake-up time not latched");
+
+	#ifdef FAST_RESUME
+	DisplayOff();
+	idle_time = 0;
+	TCNT0 = 250;							// (timer 0 overflows during the sleep)
+	OCR0B = TCNT0 + WAKE_TIME;
+	sim_sleep_hook = WakeBySystemTimer;
+	IdleSleep();
+	expected = WAKE_TIME * (1024 / 8);
+	CHECK(idle_time == expected, "display off: idle time %u, expected %u",
+		  (unsigned) idle_time, (unsigned) expected);
+	DisplayOn();
+	#endif
+	sim_sleep_hook = 0;
+}
+
+#define MAX_RECORDS	64						// frame records per animation
+
+// ping-pong playback of all animations, the frames must match a forward decode
+static void TestPingPong(void)
+{
+	static uint8_t frames[MAX_RECORDS][DISP_COLUMNS];
+	static const uint8_t* record[MAX_RECORDS];
+	uint8_t* msg = (uint8_t*) messages;
+	uint8_t frame[DISP_COLUMNS];
+	uint8_t a, n, time, repeat, changes;
+	int8_t pos, dir;
+	const uint8_t* img;
+	uint16_t calls;
+
+	InitHardware();
+	dmInit();
+	for (a = 0; a < ANIMATION_COUNT; a++) {
+		memset(frame, 0, DISP_COLUMNS);
+		n = 0;
+		img = SeekFrame((const uint8_t*) animation[a], &time);
+		while (img && (n < MAX_RECORDS)) {
+			record[n] = img;
+			img = DecodeFrame(img, frame, &repeat);
+			memcpy(frames[n++], frame, DISP_COLUMNS);
+			img = SeekFrame(img, &time);
+		}
+		CHECK(img == 0, "animation %d: more than %d frame records", a, MAX_RECORDS);
+		if (n < 2) { continue; }
+
+		msg[0] = '~';
+		msg[1] = 'a' + a;
+		msg_cache.count = 0;
+		CHECK(StartAnimation(msg, 0x80), "animation %d not started", a);
+		CHECK(player.frame == record[0] && FrontHolds(frames[0]), "animation %d: wrong first frame", a);
+
+		// forward, backward and forward again
+		pos = 0;
+		dir = 1;
+		changes = 0;
+		for (calls = 0; (calls < 10000) && (changes < 3 * (n - 1)); calls++) {
+			img = player.frame;
+			frame_timer = 0;
+			PlayAnimation();
+			if (player.frame == img) { continue; }
+			if ((pos + dir < 0) || (pos + dir >= n)) { dir = -dir; }
+			pos += dir;
+			changes++;
+			if (player.frame != record[pos]) {
+				CHECK(0, "animation %d: record %d shown, expected %d", a,
+					  (int)(player.frame - record[0]), (int)(record[pos] - record[0]));
+				break;
+			}
+			CHECK(FrontHolds(frames[pos]), "animation %d: frame %d (%s) differs from the forward decode",
+				  a, pos, (dir > 0) ? "forward" : "backward");
+		}
+		CHECK(changes == 3 * (n - 1), "animation %d: %d of %d frame changes", a, changes, 3 * (n - 1));
+	}
+}
+
+
+#if DISP_BUFFERS > 1
+// buffer swaps while dmDisplay() is not called (display interrupt disabled)
+static void TestSwap(void)
+{
+	uint8_t i;
+
+	dmInit();
+	ShowPattern(0x11);
+	CHECK(display.swap, "no swap pending after dmShow()");
+	dmStop();								// (swap pending)
+	CHECK(!display.swap, "swap still pending after dmStop()");
+	CHECK(FrontIs(0x11), "pending content not shown by dmStop()");
+
+	ShowPattern(0x22);						// must not wait for a refresh cycle
+	CHECK(!display.swap, "swap pending while the display is stopped");
+	CHECK(FrontIs(0x22), "content not shown at once while the display is stopped");
+
+	display.swap = 1;						// swap pending while stopped (0x11 is in the back buffer)
+	dmClearDisplay();						// must not wait for a refresh cycle
+	CHECK(!display.swap && FrontIs(0x11), "pending swap not done by dmClearDisplay()");
+
+	dmStart();
+	ShowPattern(0x33);
+	CHECK(display.swap && FrontIs(0x11), "swap not deferred to the refresh cycle after dmStart()");
+	for (i = 0; i < DISP_SLOTS; i++) { dmDisplay(); }
+	CHECK(!display.swap && FrontIs(0x33), "swap not done within a refresh cycle");
+}
+#endif
+
+
+#if (DISP_BUFFERS > 1) && defined(FAST_RESUME)
+// display switched off and on by the firmware with a pending buffer swap
+static void TestSleep(void)
+{
+	uint8_t i, cursor;
+
+	InitHardware();
+	dmInit();
+	if (CheckDirectory() == 0) {
+		BuildDirectory();
+	}
+	DisplayMessage(0);
+	CHECK(display.swap, "no swap pending after DisplayMessage()");
+	GoToSleep();							// right after the message (swap pending)
+	CHECK(DISPLAY_OFF && (TIMSK1 == 0), "display interrupts not disabled by GoToSleep()");
+	CHECK(!display.swap && (FRONT->cursor > 0), "message not swapped in by DisplayOff()");
+
+	cursor = FRONT->cursor;
+	ShowPattern(0x44);						// rendering while the display is off must not hang
+	CHECK(!display.swap && FrontIs(0x44), "content not shown at once while the display is off");
+
+	DisplayOn();							// (wake-up)
+	CHECK(!DISPLAY_OFF && (TIMSK1 != 0), "display interrupts not enabled by DisplayOn()");
+	DisplayMessage(0);
+	CHECK(display.swap, "swap not deferred to the refresh cycle after DisplayOn()");
+	for (i = 0; i < DISP_SLOTS; i++) { TIMER1_CAPT_vect(); }
+	CHECK(!display.swap && (FRONT->cursor == cursor), "message not shown after DisplayOn()");
+}
+#endif
+
+
+int main(int argc, char** argv)
+{
+	signal(SIGALRM, Hang);
+	alarm(TIMEOUT);
+	if (argc != 2) {
+		fprintf(stderr, "usage: display_test <case>\n");
+		return (2);
+	}
+	else if (strcmp(argv[1], "pingpong") == 0) {
+		TestPingPong();
+	}
+	else if (strcmp(argv[1], "idle") == 0) {
+		TestIdle();
+	}
+	#if DISP_BUFFERS > 1
+	else if (strcmp(argv[1], "swap") == 0) {
+		TestSwap();
+	}
+	#endif
+	#if (DISP_BUFFERS > 1) && defined(FAST_RESUME)
+	else if (strcmp(argv[1], "sleep") == 0) {
+		TestSleep();
+	}
+	#endif
+	else {
+		fprintf(stderr, "display_test: unknown case %s\n", argv[1]);
+		return (2);
+	}
+	return (failures ? 1 : 0);
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+#
+# display_test.py
+#
+# Description:	Check the display driver (dot_matrix.c) and its use by the
+#				firmware on the host. display_test.c is built with the
+#				firmware against the avr-libc stubs for every configuration
+#				below and runs the test cases listed for it.
+#
+# Usage:		test/display_test.py
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from hostbuild import TestError, build, make_variant
+
+# firmware configurations (changes of dot_matrix.h, defines of config.h, test cases)
+VARIANTS = [
+	('default', {}, [], ['pingpong', 'idle']),
+	('double buffer', {'DISP_BUFFERS': '2', 'DISP_MAX': '120'}, ['FAST_RESUME'], ['swap', 'sleep', 'pingpong', 'idle']),
+]
+
+
+def check_variant(name, changes, defines, cases):
+	tmp = tempfile.mkdtemp(prefix='display_test_')
+	try:
+		make_variant(tmp, changes)
+		exe = build(tmp, 'display_test', ['display_test.c', 'sim.c'], defines)
+		for case in cases:
+			result = subprocess.run([exe, case], capture_output=True, text=True)
+			sys.stdout.write(result.stdout)
+			sys.stderr.write(result.stderr)
+			if result.returncode != 0:
+				raise TestError('%s: %s failed' % (name, case))
+	finally:
+		shutil.rmtree(tmp)
+	print('%s: %s OK' % (name, ', '.join(cases)))
+
+
+def main():
+	try:
+		for name, changes, defines, cases in VARIANTS:
+			check_variant(name, changes, defines, cases)
+	except (TestError, subprocess.CalledProcessError) as err:
+		sys.stderr.write('display_test: %s\n' % err)
+		return 1
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main())
@@ -0,0 +1,55 @@
+#
+# hostbuild.py
+#
+# Description:	Helpers of the host tests: copy the firmware sources into a
+#				temporary directory with a changed display configuration
+#				(dot_matrix.h) and build them with the host compiler against
+#				the avr-libc stubs in test/stub.
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import os
+import re
+import shutil
+import subprocess
+
+TEST = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.join(TEST, os.pardir)
+STUB = os.path.join(TEST, 'stub')
+CC = os.environ.get('HOSTCC', 'gcc')
+CFLAGS = ['-std=gnu99', '-fgnu89-inline', '-Wall', '-DF_CPU=16000000']
+
+
+class TestError(Exception):
+	pass
+
+
+def make_variant(tmp, changes):
+	"""Copy the sources to tmp and apply the changes to dot_matrix.h
+	({name: value}, value '' enables an option that is commented out)."""
+	for name in os.listdir(ROOT):
+		if os.path.splitext(name)[1] in ('.h', '.c', '.S'):
+			shutil.copy(os.path.join(ROOT, name), tmp)
+	shutil.copytree(os.path.join(ROOT, 'animations'), os.path.join(tmp, 'animations'))
+	path = os.path.join(tmp, 'dot_matrix.h')
+	with open(path, encoding='latin-1', newline='') as f:
+		text = f.read()
+	for name, value in changes.items():
+		text, n = re.subn(r'^(//)?#define(\s+)%s\b[ \t]*\S*' % name,
+						  lambda m: '#define' + m.group(2) + name + (' ' + value if value else ''),
+						  text, count=1, flags=re.M)
+		if n != 1:
+			raise TestError('dot_matrix.h: %s not found' % name)
+	with open(path, 'w', encoding='latin-1', newline='') as f:
+		f.write(text)
+
+
+def build(tmp, exe, sources, defines=()):
+	"""Build sources (relative to test/ or tmp) into tmp/exe, return its path."""
+	path = os.path.join(tmp, exe)
+	files = [s if os.path.isabs(s) else os.path.join(TEST, s) for s in sources]
+	subprocess.run([CC] + CFLAGS + ['-D' + d for d in defines]
+				   + ['-I', tmp, '-I', STUB, '-o', path] + files, check=True)
+	return path
@@ -0,0 +1,71 @@
+/*
+ * isr_ref.c
+ *
+ * Reference for isr_test.py: runs the C version of the display interrupt
+ * (dmDisplay()) on a scenario read from stdin and prints the port outputs.
+ *
+ * Input (one command per line):
+ *	m <index> <value>		write display memory
+ *	b <base>				set the scroll base (applied at the next refresh cycle)
+ *	p <portb> <portc> <portd>	set the ports (pins that are not connected to the display)
+ *	d						call dmDisplay() and print "PORTB PORTC PORTD"
+ *
+ * Before the scenario the lookup tables, DISP_SLOTS and the offset of
+ * display.base are printed for the assembler simulation.
+ */
+
+#include <stdio.h>
+#include "dot_matrix.c"
+
+
+static void print_table(const char* name, const uint8_t* table, uint8_t size)
+{
+	uint8_t i;
+
+	printf("lut %s", name);
+	for (i = 0; i < size; i++) { printf(" %d", table[i]); }
+	printf("\n");
+}
+
+
+int main(void)
+{
+	char cmd[2];
+	unsigned int a, b, c;
+
+	dmInit();
+	print_table("row_lut_b", row_lut_b, sizeof(row_lut_b));
+	print_table("row_lut_c", row_lut_c, sizeof(row_lut_c));
+	print_table("row_lut_d", row_lut_d, sizeof(row_lut_d));
+	print_table("col_lut_b", col_lut_b, sizeof(col_lut_b));
+	print_table("col_lut_c", col_lut_c, sizeof(col_lut_c));
+	print_table("col_lut_d", col_lut_d, sizeof(col_lut_d));
+	printf("base %d\n", (int) offsetof(display_t, base));
+	printf("slots %d\n", DISP_SLOTS);
+
+	while (scanf("%1s", cmd) == 1) {
+		switch (cmd[0]) {
+		case 'm':
+			if (scanf("%u %u", &a, &b) != 2) { return (1); }
+			FRONT->memory[a] = b;
+			break;
+		case 'b':
+			if (scanf("%u", &a) != 1) { return (1); }
+			display.base = a;
+			break;
+		case 'p':
+			if (scanf("%u %u %u", &a, &b, &c) != 3) { return (1); }
+			PORTB = a;
+			PORTC = b;
+			PORTD = c;
+			break;
+		case 'd':
+			dmDisplay();
+			printf("%d %d %d\n", PORTB, PORTC, PORTD);
+			break;
+		default:
+			return (1);
+		}
+	}
+	return (0);
+}
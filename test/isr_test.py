@@ -0,0 +1,432 @@
+#!/usr/bin/env python3
+#
+# isr_test.py
+#
+# Description:	Check the assembler display interrupt (dot_matrix_isr.S,
+#				DISP_ASM_ISR) against the C version (dmDisplay()).
+#				The C version is built for the host (isr_ref.c), the
+#				assembler source is run by a small simulator of the AVR
+#				instructions it uses. Both get the same scenario of display
+#				memory contents, scrolling steps and port states and have to
+#				produce the same PORTB/PORTC/PORTD output for every column.
+#				The simulator also checks that all registers and SREG are
+#				preserved, the latency and overrun statistics and the cycle
+#				counts documented in dot_matrix_isr.S.
+#
+# Usage:		test/isr_test.py
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from hostbuild import CC, CFLAGS, STUB, TestError, build, make_variant
+
+DEFINES = ['DISP_ASM_ISR']
+
+STEPS = 3000
+SEED = 1
+
+# display configurations (changes of dot_matrix.h)
+VARIANTS = [
+	('default', {}),
+	('blank slot', {'DISP_BLANK_SLOTS': '1'}),
+	('common anode', {'DISP_TYPE': '1'}),
+	('upside down', {'DISP_UPDOWN': ''}),
+	('large memory', {'DISP_MAX': '240'}),
+]
+
+# data space
+SREG = 0x5F
+PORTS = (0x25, 0x28, 0x2B)					# PORTB, PORTC, PORTD
+TIFR1 = 0x36
+ICF1 = 5
+GPIOR0 = 0x3E
+TCNT1L = 0x84
+TCNT1H = 0x85
+RAMEND = 0x8FF
+SYMBOLS = {'display': 0x100, 'disp_latency': 0x300, 'disp_overruns': 0x302}
+FLASH_TABLES = 0x1000						# flash address of the lookup tables
+
+# documented cycle counts (dot_matrix_isr.S)
+CYCLES_COLUMN = 126
+CYCLES_FIRST = 129
+CYCLES_BLANK_SLOT = 124
+CYCLES_BLANK_EXTRA = 3
+CYCLES_NEW_MAX = 3
+CYCLES_OVERRUN = 13
+CYCLES_ENTRY = 7							# interrupt response and jmp from the vector table
+
+# cycles of the instructions (without taken branches and skips)
+CYCLES = {
+	'push': 2, 'pop': 2, 'in': 1, 'out': 1, 'lds': 2, 'sts': 2, 'ld': 2, 'lpm': 3,
+	'mov': 1, 'ldi': 1, 'clr': 1, 'inc': 1, 'add': 1, 'subi': 1, 'sbci': 1, 'andi': 1,
+	'or': 1, 'eor': 1, 'cp': 1, 'cpc': 1, 'cpi': 1, 'adiw': 2, 'brsh': 1, 'brlo': 1,
+	'rjmp': 2, 'sbic': 1, 'reti': 4, 'nop': 1,
+}
+TWO_WORDS = ('lds', 'sts')
+
+
+def lo8(x):
+	return x & 0xFF
+
+
+def hi8(x):
+	return (x >> 8) & 0xFF
+
+
+class Program:
+	"""Assembler source after the C preprocessor, macros expanded."""
+
+	def __init__(self, text):
+		self.code = []						# (mnemonic, operands, source line)
+		self.labels = {}
+		self.local = []						# (number, index) of numeric labels
+		macros = {}
+		lines = [re.sub(r'//.*|;.*', '', l).strip() for l in text.splitlines()]
+		lines = [l for l in lines if l and not l.startswith('#')]
+		i = 0
+		while i < len(lines):
+			line = lines[i]
+			i += 1
+			if line.startswith('.macro'):
+				words = line.split(None, 2)
+				params = [p.strip() for p in words[2].split(',')] if len(words) > 2 else []
+				body = []
+				while not lines[i].startswith('.endm'):
+					body.append(lines[i])
+					i += 1
+				i += 1
+				macros[words[1]] = (params, body)
+				continue
+			name = line.split(None, 1)[0]
+			if name in macros:
+				params, body = macros[name]
+				args = [a.strip() for a in line.split(None, 1)[1].split(',')]
+				expanded = []
+				for b in body:
+					for p, a in zip(params, args):
+						b = b.replace('\\' + p, a)
+					expanded.append(b)
+				lines[i:i] = expanded
+				continue
+			self.add(line)
+
+	def add(self, line):
+		m = re.match(r'^(\w+):\s*(.*)$', line)
+		if m:
+			if m.group(1).isdigit():
+				self.local.append((m.group(1), len(self.code)))
+			else:
+				self.labels[m.group(1)] = len(self.code)
+			if m.group(2):
+				self.add(m.group(2))
+			return
+		if line.startswith('.'):
+			return							# directive
+		words = line.split(None, 1)
+		operands = [o.strip() for o in words[1].split(',')] if len(words) > 1 else []
+		self.code.append((words[0], operands, line))
+
+	def target(self, operand, index):
+		m = re.match(r'^(\d+)([fb])$', operand)
+		if not m:
+			return self.labels[operand]
+		if m.group(2) == 'f':
+			return min(i for n, i in self.local if n == m.group(1) and i > index)
+		return max(i for n, i in self.local if n == m.group(1) and i <= index)
+
+
+class Cpu:
+	"""The AVR instructions used by the display interrupt."""
+
+	def __init__(self, program, symbols, flash):
+		self.program = program
+		self.symbols = symbols
+		self.flash = flash
+		self.r = [0] * 32
+		self.mem = bytearray(RAMEND + 1)
+		self.sp = RAMEND
+
+	def value(self, expr):
+		expr = expr.replace('/', '//')
+		return int(eval(expr, {'lo8': lo8, 'hi8': hi8, '__builtins__': {}}, self.symbols))
+
+	@staticmethod
+	def reg(operand):
+		return int(operand[1:])
+
+	def flag(self, bit):
+		return (self.mem[SREG] >> bit) & 1
+
+	def set_flags(self, **flags):
+		bits = {'C': 0, 'Z': 1, 'N': 2, 'V': 3, 'S': 4, 'H': 5}
+		sreg = self.mem[SREG]
+		for name, on in flags.items():
+			sreg &= ~(1 << bits[name])
+			if on:
+				sreg |= 1 << bits[name]
+		self.mem[SREG] = sreg
+
+	def subtract(self, a, b, carry, keep_z):
+		res = (a - b - carry) & 0xFF
+		n = res >> 7
+		v = ((a ^ b) & (a ^ res)) >> 7 & 1
+		z = (res == 0) and (not keep_z or self.flag(1))
+		self.set_flags(C=a < b + carry, Z=z, N=n, V=v, S=n ^ v,
+					   H=(a & 0x0F) < (b & 0x0F) + carry)
+		return res
+
+	def logic(self, res):
+		self.set_flags(Z=res == 0, N=res >> 7, V=0, S=res >> 7)
+		return res
+
+	def z(self):
+		return self.r[30] | (self.r[31] << 8)
+
+	def push(self, x):
+		self.mem[self.sp] = x
+		self.sp -= 1
+
+	def pop(self):
+		self.sp += 1
+		return self.mem[self.sp]
+
+	def run(self, entry):
+		"""Execute an interrupt routine, return the number of cycles."""
+		self.push(0x12)						# return address
+		self.push(0x34)
+		self.mem[SREG] &= 0x7F				# interrupts disabled
+		pc = self.program.labels[entry]
+		cycles = CYCLES_ENTRY
+		while True:
+			op, ops, line = self.program.code[pc]
+			pc += 1
+			cycles += CYCLES[op]
+			r = self.r
+			if op == 'push':
+				self.push(r[self.reg(ops[0])])
+			elif op == 'pop':
+				r[self.reg(ops[0])] = self.pop()
+			elif op == 'in':
+				r[self.reg(ops[0])] = self.mem[self.value(ops[1]) + 0x20]
+			elif op == 'out':
+				self.mem[self.value(ops[0]) + 0x20] = r[self.reg(ops[1])]
+			elif op == 'lds':
+				r[self.reg(ops[0])] = self.mem[self.value(ops[1])]
+			elif op == 'sts':
+				self.mem[self.value(ops[0])] = r[self.reg(ops[1])]
+			elif op == 'ld':
+				if ops[1] != 'Z':
+					raise TestError('unsupported: ' + line)
+				r[self.reg(ops[0])] = self.mem[self.z()]
+			elif op == 'lpm':
+				if ops[1] != 'Z':
+					raise TestError('unsupported: ' + line)
+				if self.z() not in self.flash:
+					raise TestError('lpm from 0x%04X outside the lookup tables' % self.z())
+				r[self.reg(ops[0])] = self.flash[self.z()]
+			elif op == 'mov':
+				r[self.reg(ops[0])] = r[self.reg(ops[1])]
+			elif op == 'ldi':
+				r[self.reg(ops[0])] = self.value(ops[1]) & 0xFF
+			elif op == 'clr':
+				r[self.reg(ops[0])] = self.logic(0)
+			elif op == 'inc':
+				res = (r[self.reg(ops[0])] + 1) & 0xFF
+				self.set_flags(Z=res == 0, N=res >> 7, V=res == 0x80, S=(res >> 7) ^ (res == 0x80))
+				r[self.reg(ops[0])] = res
+			elif op == 'add':
+				a, b = r[self.reg(ops[0])], r[self.reg(ops[1])]
+				res = (a + b) & 0xFF
+				n = res >> 7
+				v = (~(a ^ b) & (a ^ res)) >> 7 & 1
+				self.set_flags(C=a + b > 0xFF, Z=res == 0, N=n, V=v, S=n ^ v,
+							   H=(a & 0x0F) + (b & 0x0F) > 0x0F)
+				r[self.reg(ops[0])] = res
+			elif op in ('subi', 'cpi'):
+				res = self.subtract(r[self.reg(ops[0])], self.value(ops[1]) & 0xFF, 0, False)
+				if op == 'subi':
+					r[self.reg(ops[0])] = res
+			elif op == 'sbci':
+				r[self.reg(ops[0])] = self.subtract(r[self.reg(ops[0])], self.value(ops[1]) & 0xFF,
+													self.flag(0), True)
+			elif op == 'cp':
+				self.subtract(r[self.reg(ops[0])], r[self.reg(ops[1])], 0, False)
+			elif op == 'cpc':
+				self.subtract(r[self.reg(ops[0])], r[self.reg(ops[1])], self.flag(0), True)
+			elif op == 'andi':
+				r[self.reg(ops[0])] = self.logic(r[self.reg(ops[0])] & self.value(ops[1]) & 0xFF)
+			elif op == 'or':
+				r[self.reg(ops[0])] = self.logic(r[self.reg(ops[0])] | r[self.reg(ops[1])])
+			elif op == 'eor':
+				r[self.reg(ops[0])] = self.logic(r[self.reg(ops[0])] ^ r[self.reg(ops[1])])
+			elif op == 'adiw':
+				d = self.reg(ops[0])
+				a = r[d] | (r[d + 1] << 8)
+				res = (a + self.value(ops[1])) & 0xFFFF
+				self.set_flags(C=res < a, Z=res == 0, N=res >> 15, V=(~a & res) >> 15 & 1,
+							   S=(res >> 15) ^ ((~a & res) >> 15 & 1))
+				r[d], r[d + 1] = res & 0xFF, res >> 8
+			elif op in ('brsh', 'brlo'):
+				if self.flag(0) == (op == 'brlo'):
+					pc = self.program.target(ops[0], pc - 1)
+					cycles += 1
+			elif op == 'rjmp':
+				pc = self.program.target(ops[0], pc - 1)
+			elif op == 'sbic':
+				if not (self.mem[self.value(ops[0]) + 0x20] >> self.value(ops[1])) & 1:
+					skipped = self.program.code[pc][0]
+					pc += 1
+					cycles += 2 if skipped in TWO_WORDS else 1
+			elif op == 'nop':
+				pass
+			elif op == 'reti':
+				self.pop()
+				self.pop()
+				self.mem[SREG] |= 0x80
+				return cycles
+			else:
+				raise TestError('unsupported instruction: ' + line)
+
+
+def run_c(tmp, scenario):
+	exe = build(tmp, 'isr_ref', ['isr_ref.c', 'sim.c'], DEFINES)
+	result = subprocess.run([exe], input='\n'.join(scenario) + '\n', capture_output=True,
+							text=True, check=True)
+	return result.stdout.splitlines()
+
+
+def preprocess(tmp):
+	result = subprocess.run([CC, '-E', '-P', '-x', 'assembler-with-cpp', '-D__ASSEMBLER__']
+							+ CFLAGS[2:] + ['-D' + d for d in DEFINES] + ['-I', tmp, '-I', STUB,
+							os.path.join(tmp, 'dot_matrix_isr.S')],
+							capture_output=True, text=True, check=True)
+	return result.stdout
+
+
+def make_scenario(rng, disp_max):
+	scenario = ['m %d %d' % (i, rng.randrange(256)) for i in range(disp_max)]
+	for step in range(STEPS):
+		if rng.random() < 0.2:
+			scenario.append('m %d %d' % (rng.randrange(disp_max), rng.randrange(256)))
+		if rng.random() < 0.1:
+			scenario.append('b %d' % rng.randrange(disp_max - 4))
+		if rng.random() < 0.1:
+			scenario.append('p %d %d %d' % tuple(rng.randrange(256) for i in range(3)))
+		scenario.append('d')
+	return scenario
+
+
+def check_variant(name, changes, rng):
+	tmp = tempfile.mkdtemp(prefix='isr_test_')
+	try:
+		make_variant(tmp, changes)
+		disp_max = int(changes.get('DISP_MAX', 200))
+		scenario = make_scenario(rng, disp_max)
+		output = run_c(tmp, scenario)
+		program = Program(preprocess(tmp))
+	finally:
+		shutil.rmtree(tmp)
+
+	flash = {}
+	symbols = dict(SYMBOLS)
+	expected = []
+	for line in output:
+		words = line.split()
+		if words[0] == 'lut':
+			addr = FLASH_TABLES + 0x100 * len([s for s in symbols if s.endswith('_lut_b')
+											   or s.endswith('_lut_c') or s.endswith('_lut_d')])
+			symbols[words[1]] = addr
+			for i, v in enumerate(words[2:]):
+				flash[addr + i] = int(v)
+		elif words[0] == 'base':
+			base_ofs = int(words[1])
+		elif words[0] == 'slots':
+			slots = int(words[1])
+		else:
+			expected.append(tuple(int(w) for w in words))
+	blank_slots = int(changes.get('DISP_BLANK_SLOTS', 0))
+	columns = slots - blank_slots
+
+	cpu = Cpu(program, symbols, flash)
+	display = symbols['display']
+	latency = 0
+	overruns = 0
+	col = 0
+	n = 0
+	for cmd in scenario:
+		words = cmd.split()
+		if words[0] == 'm':
+			cpu.mem[display + int(words[1])] = int(words[2])
+		elif words[0] == 'b':
+			cpu.mem[display + base_ofs] = int(words[1])
+		elif words[0] == 'p':
+			for port, value in zip(PORTS, words[1:]):
+				cpu.mem[port] = int(value)
+		else:
+			regs = [rng.randrange(256) for i in range(32)]
+			cpu.r = list(regs)
+			sreg = rng.randrange(128)
+			cpu.mem[SREG] = sreg
+			tcnt = rng.randrange(400)
+			cpu.mem[TCNT1L], cpu.mem[TCNT1H] = tcnt & 0xFF, tcnt >> 8
+			overrun = rng.random() < 0.05
+			cpu.mem[TIFR1] = (1 << ICF1) if overrun else 0
+			sp = cpu.sp
+			cycles = cpu.run('TIMER1_CAPT_vect')
+
+			col = (col + 1) % slots
+			ports = tuple(cpu.mem[p] for p in PORTS)
+			if ports != expected[n]:
+				raise TestError('%s: column %d (step %d): assembler %s, C %s'
+								% (name, col, n, ports, expected[n]))
+			if cpu.r != regs or cpu.mem[SREG] != sreg | 0x80 or cpu.sp != sp:
+				raise TestError('%s: registers not preserved (step %d)' % (name, n))
+			if cpu.mem[GPIOR0] != col:
+				raise TestError('%s: GPIOR0 = %d, expected column %d' % (name, cpu.mem[GPIOR0], col))
+
+			new_max = tcnt > latency
+			latency = max(latency, tcnt)
+			overruns += overrun
+			stat = symbols['disp_latency']
+			if cpu.mem[stat] | (cpu.mem[stat + 1] << 8) != latency:
+				raise TestError('%s: disp_latency wrong (step %d)' % (name, n))
+			stat = symbols['disp_overruns']
+			if cpu.mem[stat] | (cpu.mem[stat + 1] << 8) != overruns & 0xFFFF:
+				raise TestError('%s: disp_overruns wrong (step %d)' % (name, n))
+
+			if col >= columns:
+				documented = CYCLES_BLANK_SLOT
+			else:
+				documented = CYCLES_FIRST if col == 0 else CYCLES_COLUMN
+				if blank_slots:
+					documented += CYCLES_BLANK_EXTRA
+			documented += CYCLES_NEW_MAX * new_max + CYCLES_OVERRUN * overrun
+			if cycles != documented:
+				raise TestError('%s: column %d takes %d cycles, documented %d'
+								% (name, col, cycles, documented))
+			n += 1
+	print('%s: %d columns OK' % (name, n))
+
+
+def main():
+	rng = random.Random(SEED)
+	try:
+		for name, changes in VARIANTS:
+			check_variant(name, changes, rng)
+	except (TestError, subprocess.CalledProcessError) as err:
+		sys.stderr.write('isr_test: %s\n' % err)
+		return 1
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main())
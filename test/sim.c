@@ -0,0 +1,90 @@
+/*
+ * sim.c
+ *
+ * Simulated hardware for the host tests: I/O registers, UART data
+ * register, EEPROM and sleep mode of the ATmega328P.
+ */
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+#include "sim.h"
+
+#define SIM_DEF8(name)		volatile uint8_t name;
+#define SIM_DEF16(name)		volatile uint16_t name;
+
+SIM_DEF8(PORTB) SIM_DEF8(PORTC) SIM_DEF8(PORTD) SIM_DEF8(PINB) SIM_DEF8(PINC) SIM_DEF8(PIND)
+SIM_DEF8(DDRB) SIM_DEF8(DDRC) SIM_DEF8(DDRD)
+SIM_DEF8(TCCR0A) SIM_DEF8(TCCR0B) SIM_DEF8(OCR0A) SIM_DEF8(OCR0B) SIM_DEF8(TCNT0) SIM_DEF8(TIMSK0) SIM_DEF8(TIFR0)
+SIM_DEF8(TCCR1A) SIM_DEF8(TCCR1B) SIM_DEF16(ICR1) SIM_DEF16(OCR1A) SIM_DEF16(OCR1B) SIM_DEF16(TCNT1)
+SIM_DEF8(TIMSK1) SIM_DEF8(TIFR1)
+SIM_DEF8(PCIFR) SIM_DEF8(PCMSK2) SIM_DEF8(PCICR) SIM_DEF8(ADCSRA) SIM_DEF8(GPIOR0) SIM_DEF8(GPIOR1)
+SIM_DEF8(UCSR0A) SIM_DEF8(UCSR0B) SIM_DEF8(UCSR0C) SIM_DEF16(UBRR0)
+
+uint8_t sim_tx[SIM_TX_MAX];
+uint16_t sim_tx_count = 0;
+uint8_t sim_rx_byte = 0;
+uint8_t sim_rx_pending = 0;
+uint8_t sim_eeprom_busy = 0;
+uint16_t sim_eeprom_writes = 0;
+void (*sim_sleep_hook)(void) = 0;
+
+
+// UDR0: The firmware reads UDR0 only once at the start of the receive
+// interrupt (sim_rx_pending), every other access is a write to the transmitter.
+volatile uint8_t* sim_udr(void)
+{
+	static volatile uint8_t discard;
+
+	if (sim_rx_pending) {
+		sim_rx_pending = 0;
+		return (&sim_rx_byte);
+	}
+	if (sim_tx_count >= SIM_TX_MAX) { return (&discard); }
+	return (&sim_tx[sim_tx_count++]);
+}
+
+
+// EEPROM (the EEMEM variables are ordinary variables on the host)
+uint8_t eeprom_read_byte(const uint8_t* addr)
+{
+	return (*addr);
+}
+
+void eeprom_read_block(void* dst, const void* src, size_t n)
+{
+	const uint8_t* s = src;
+	uint8_t* d = dst;
+
+	while (n--) { *d++ = *s++; }
+}
+
+void eeprom_update_byte(uint8_t* addr, uint8_t value)
+{
+	if (*addr != value) {
+		*addr = value;
+		sim_eeprom_writes++;
+	}
+}
+
+int eeprom_is_ready(void)
+{
+	return (!sim_eeprom_busy);
+}
+
+
+// sleep mode
+void set_sleep_mode(int mode)
+{
+	(void) mode;
+}
+
+void sleep_mode(void)
+{
+	if (sim_sleep_hook) { sim_sleep_hook(); }
+}
+
+void sleep_cpu(void)
+{
+	if (sim_sleep_hook) { sim_sleep_hook(); }
+}
@@ -0,0 +1,22 @@
+/*
+ * sim.h
+ *
+ * Simulated hardware for the host tests (see sim.c).
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#define SIM_TX_MAX		1024
+
+extern uint8_t sim_tx[SIM_TX_MAX];		// bytes written to UDR0
+extern uint16_t sim_tx_count;
+extern uint8_t sim_rx_byte;				// byte returned by the next read of UDR0
+extern uint8_t sim_rx_pending;			// 1 = the next access of UDR0 is a read
+extern uint8_t sim_eeprom_busy;			// 1 = eeprom_is_ready() returns 0
+extern uint16_t sim_eeprom_writes;		// number of EEPROM bytes written
+extern void (*sim_sleep_hook)(void);	// called by sleep_mode() and sleep_cpu() (0 = return at once)
+
+#endif
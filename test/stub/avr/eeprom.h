@@ -0,0 +1,19 @@
+// Host replacement of the avr-libc header for the tests in test/.
+// The EEPROM variables are plain variables, the access functions are in sim.c.
+// EEMEM places them in a writable section, even if they are declared const.
+#ifndef STUB_AVR_EEPROM_H
+#define STUB_AVR_EEPROM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EEMEM_NAME(n)	EEMEM_STR(n)
+#define EEMEM_STR(n)	".data.eemem" #n
+#define EEMEM			__attribute__((section(EEMEM_NAME(__COUNTER__))))	// (one section per variable)
+
+uint8_t eeprom_read_byte(const uint8_t* addr);
+void eeprom_read_block(void* dst, const void* src, size_t n);
+void eeprom_update_byte(uint8_t* addr, uint8_t value);
+int eeprom_is_ready(void);
+
+#endif
@@ -0,0 +1,11 @@
+// Host replacement of the avr-libc header for the tests in test/.
+// Interrupt routines are plain functions that the tests call directly.
+#ifndef STUB_AVR_INTERRUPT_H
+#define STUB_AVR_INTERRUPT_H
+
+#define ISR(vector, ...)	void vector(void)
+#define ISR_NOBLOCK
+#define sei()
+#define cli()
+
+#endif
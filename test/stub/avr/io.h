@@ -0,0 +1,89 @@
+/*
+ * avr/io.h
+ *
+ * Host replacement of the avr-libc header for the tests in test/.
+ * In C the I/O registers are plain variables (defined in sim.c), in
+ * assembler they have the data space addresses of the ATmega328P.
+ */
+
+#ifndef STUB_AVR_IO_H
+#define STUB_AVR_IO_H
+
+// data space addresses (assembler only, see isr_test.py)
+#ifdef __ASSEMBLER__
+
+#define _SFR_IO_ADDR(sfr)	((sfr) - 0x20)
+#define PORTB		0x25
+#define PORTC		0x28
+#define PORTD		0x2B
+#define TIFR1		0x36
+#define GPIOR0		0x3E
+#define GPIOR1		0x4A
+#define SREG		0x5F
+#define TCNT1L		0x84
+#define TCNT1H		0x85
+
+#else
+
+#include <stdint.h>
+
+#define SIM_REG8(name)		extern volatile uint8_t name;
+#define SIM_REG16(name)		extern volatile uint16_t name;
+
+SIM_REG8(PORTB) SIM_REG8(PORTC) SIM_REG8(PORTD) SIM_REG8(PINB) SIM_REG8(PINC) SIM_REG8(PIND)
+SIM_REG8(DDRB) SIM_REG8(DDRC) SIM_REG8(DDRD)
+SIM_REG8(TCCR0A) SIM_REG8(TCCR0B) SIM_REG8(OCR0A) SIM_REG8(OCR0B) SIM_REG8(TCNT0) SIM_REG8(TIMSK0) SIM_REG8(TIFR0)
+SIM_REG8(TCCR1A) SIM_REG8(TCCR1B) SIM_REG16(ICR1) SIM_REG16(OCR1A) SIM_REG16(OCR1B) SIM_REG16(TCNT1)
+SIM_REG8(TIMSK1) SIM_REG8(TIFR1)
+SIM_REG8(PCIFR) SIM_REG8(PCMSK2) SIM_REG8(PCICR) SIM_REG8(ADCSRA) SIM_REG8(GPIOR0) SIM_REG8(GPIOR1)
+SIM_REG8(UCSR0A) SIM_REG8(UCSR0B) SIM_REG8(UCSR0C) SIM_REG16(UBRR0)
+
+// UDR0 is the receive register when read and the transmit register when written,
+// see sim_udr() in sim.c
+volatile uint8_t* sim_udr(void);
+#define UDR0		(*sim_udr())
+
+#endif
+
+// bit numbers
+#define CS00		0
+#define CS02		2
+#define OCIE0B		2
+#define CS11		1
+#define WGM12		3
+#define WGM13		4
+#define OCIE1A		1
+#define OCIE1B		2
+#define ICIE1		5
+#define OCF1A		1
+#define OCF1B		2
+#define ICF1		5
+#define PCIF2		2
+#define PCIE2		2
+#define PCINT16		0
+#define RXC0		7
+#define UDRE0		5
+#define FE0			4
+#define DOR0		3
+#define U2X0		1
+#define RXCIE0		7
+#define RXEN0		4
+#define TXEN0		3
+#define UCSZ00		1
+#define UCSZ01		2
+
+#define _BV(bit)	(1 << (bit))
+#define bit_is_set(sfr, bit)			((sfr) & _BV(bit))
+#define bit_is_clear(sfr, bit)			(!((sfr) & _BV(bit)))
+#define loop_until_bit_is_set(sfr, bit)	do { } while (bit_is_clear(sfr, bit))
+
+#ifndef __ASSEMBLER__
+struct __fuse_t {
+	uint8_t low;
+	uint8_t high;
+	uint8_t extended;
+};
+#define FUSES		static const struct __fuse_t __fuse __attribute__((unused))
+#endif
+
+#endif
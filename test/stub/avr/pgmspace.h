@@ -0,0 +1,13 @@
+// Host replacement of the avr-libc header for the tests in test/.
+#ifndef STUB_AVR_PGMSPACE_H
+#define STUB_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr)	(*(const uint8_t*)(addr))
+#define pgm_read_word(addr)	(*(addr))			// (also reads the pointer tables of animations.h)
+#define memcpy_P			memcpy
+
+#endif
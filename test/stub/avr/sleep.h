@@ -0,0 +1,14 @@
+// Host replacement of the avr-libc header for the tests in test/.
+#ifndef STUB_AVR_SLEEP_H
+#define STUB_AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE		0
+#define SLEEP_MODE_PWR_DOWN	2
+
+void set_sleep_mode(int mode);
+void sleep_mode(void);
+void sleep_cpu(void);
+#define sleep_enable()
+#define sleep_disable()
+
+#endif
@@ -0,0 +1,9 @@
+// Host replacement of the avr-libc header for the tests in test/.
+// The tests are single-threaded, an atomic block is a plain block.
+#ifndef STUB_UTIL_ATOMIC_H
+#define STUB_UTIL_ATOMIC_H
+
+#define ATOMIC_BLOCK(type)	for (int __done = 0; !__done; __done = 1)
+#define ATOMIC_RESTORESTATE
+
+#endif
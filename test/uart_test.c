@@ -0,0 +1,305 @@
+/*
+ * uart_test.c
+ *
+ * Host test of the serial message upload (UploadService(), UploadFrame() and
+ * the receive interrupt, UART_UPLOAD) and of the live text (UART_LIVE).
+ * Built and run by uart_test.py, the firmware (main.c) is part of this file.
+ *
+ * Usage:	uart_test upload frames.bin image.bin count
+ *			(frames written by tools/msgupload.py -o, the message data they
+ *			contain and the number of messages)
+ *			uart_test live
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+#define main firmware_main
+#include "main.c"
+#undef main
+
+
+/***********
+ * helpers *
+ ***********/
+
+static int failures = 0;
+
+#define CHECK(cond, ...)										\
+	do {														\
+		if (!(cond)) {											\
+			printf("FAIL %s:%d: ", __FILE__, __LINE__);			\
+			printf(__VA_ARGS__);								\
+			printf("\n");										\
+			failures++;											\
+		}														\
+	} while (0)
+
+// one byte from the sender
+static void Receive(uint8_t ch)
+{
+	sim_rx_byte = ch;
+	sim_rx_pending = 1;
+	USART_RX_vect();
+}
+
+// one system timer cycle with the push button released
+static void Tick(void)
+{
+	PIND = 0xFF;
+	TIMER0_COMPB_vect();
+}
+
+// main loop passes
+static void Service(uint16_t passes)
+{
+	while (passes--) { UploadService(); }
+}
+
+// bytes sent by the firmware since the last call (as text, e. g. "ACK NAK")
+static const char* Answer(void)
+{
+	static char text[256];
+	uint16_t i;
+
+	text[0] = 0;
+	for (i = 0; (i < sim_tx_count) && (strlen(text) < sizeof(text) - 8); i++) {
+		if (i) { strcat(text, " "); }
+		switch (sim_tx[i]) {
+			case UART_ACK:	strcat(text, "ACK");	break;
+			case UART_NAK:	strcat(text, "NAK");	break;
+			case UART_XON:	strcat(text, "XON");	break;
+			case UART_XOFF:	strcat(text, "XOFF");	break;
+			default:		sprintf(text + strlen(text), "0x%02X", sim_tx[i]);
+		}
+	}
+	sim_tx_count = 0;
+	return (text);
+}
+
+// frame of the upload protocol, returns its length
+static uint8_t MakeFrame(uint8_t* frame, uint8_t cmd, const uint8_t* data, uint8_t len)
+{
+	uint16_t crc = 0xFFFF;
+	uint8_t i;
+
+	frame[0] = UART_SYNC;
+	frame[1] = cmd;
+	frame[2] = len;
+	memcpy(&frame[3], data, len);
+	for (i = 1; i < len + 3; i++) { crc = _crc_ccitt_update(crc, frame[i]); }
+	frame[len + 3] = crc & 0xFF;
+	frame[len + 4] = crc >> 8;
+	return (len + 5);
+}
+
+// send a frame byte by byte (one main loop pass per byte) and write its data
+static const char* SendFrame(const uint8_t* frame, uint8_t len)
+{
+	uint8_t i;
+
+	for (i = 0; i < len; i++) {
+		Receive(frame[i]);
+		Service(1);
+	}
+	Service(2 * UART_BLOCK_SIZE);
+	return (Answer());
+}
+
+static void Start(void)
+{
+	InitHardware();
+	UCSR0A |= _BV(UDRE0);					// transmitter always ready
+	TCNT1 = 0;
+	dmInit();
+	if (CheckDirectory() == 0) {
+		BuildDirectory();
+	}
+	DisplayMessage(0);
+	sim_tx_count = 0;
+}
+
+
+/****************
+ * upload tests *
+ ****************/
+
+static void TestUpload(const char* frames_name, const char* image_name, int count)
+{
+	static uint8_t frames[4096], image[MSG_SIZE], before[MSG_SIZE], frame[300];
+	FILE* f;
+	size_t size, image_size, pos;
+	uint8_t len, data[UART_BLOCK_SIZE + 2], n, first;
+	const char* answer;
+
+	f = fopen(frames_name, "rb");
+	if (!f) { perror(frames_name); exit(2); }
+	size = fread(frames, 1, sizeof(frames), f);
+	fclose(f);
+	f = fopen(image_name, "rb");
+	if (!f) { perror(image_name); exit(2); }
+	image_size = fread(image, 1, sizeof(image), f);
+	fclose(f);
+
+	Start();
+	memcpy(before, messages, MSG_SIZE);
+	first = frames[2] + 5;					// length of the first frame
+
+	// corrupted frame
+	memcpy(frame, frames, first);
+	frame[5] ^= 0x01;
+	answer = SendFrame(frame, first);
+	CHECK(strcmp(answer, "NAK") == 0, "corrupted frame: answer \"%s\", expected NAK", answer);
+	CHECK(memcmp(before, messages, MSG_SIZE) == 0, "corrupted frame changed the EEPROM");
+
+	// truncated frame, dropped after UART_TIMEOUT
+	SendFrame(frames, 4);
+	for (n = 0; n <= UART_TIMEOUT; n++) { Tick(); }
+	Service(1);
+	answer = Answer();
+	CHECK(answer[0] == 0, "truncated frame: answer \"%s\", expected none", answer);
+	CHECK(upload.state == UP_SYNC, "truncated frame not dropped (state %d)", upload.state);
+	CHECK(memcmp(before, messages, MSG_SIZE) == 0, "truncated frame changed the EEPROM");
+
+	// oversized frame (its data bytes do not contain UART_SYNC)
+	memset(data, 'x', sizeof(data));
+	len = MakeFrame(frame, UART_CMD_WRITE, data, sizeof(data));
+	answer = SendFrame(frame, len);
+	CHECK(strcmp(answer, "NAK") == 0, "oversized frame: answer \"%s\", expected NAK", answer);
+
+	// write beyond messages[]
+	data[0] = MSG_SIZE - 4;
+	len = MakeFrame(frame, UART_CMD_WRITE, data, 8);
+	answer = SendFrame(frame, len);
+	CHECK(strcmp(answer, "NAK") == 0, "write beyond messages[]: answer \"%s\", expected NAK", answer);
+
+	// unknown command
+	len = MakeFrame(frame, 'X', data, 2);
+	answer = SendFrame(frame, len);
+	CHECK(strcmp(answer, "NAK") == 0, "unknown command: answer \"%s\", expected NAK", answer);
+	CHECK(memcmp(before, messages, MSG_SIZE) == 0, "rejected frames changed the EEPROM");
+
+	// write scheduling: no write while the EEPROM is busy or outside the write window
+	for (n = 0; n < first; n++) { Receive(frames[n]); }
+	Service(1);
+	CHECK(upload.state == UP_WRITE, "first frame not accepted (state %d)", upload.state);
+	CHECK(UPLOADING, "rendering not stopped during the upload");
+	n = upload.count;
+	TCNT1 = EEPROM_WRITE_WINDOW + 1;
+	Service(10);
+	CHECK(upload.count == n, "EEPROM written outside the write window");
+	TCNT1 = 0;
+	sim_eeprom_busy = 1;
+	Service(10);
+	CHECK(upload.count == n, "EEPROM written while busy");
+	sim_eeprom_busy = 0;
+	while (upload.state == UP_WRITE) {
+		n = upload.count;
+		answer = Answer();
+		CHECK(answer[0] == 0, "answer \"%s\" before the frame has been written", answer);
+		Service(1);
+		CHECK(upload.count - n <= 1, "more than one EEPROM write per pass");
+	}
+	answer = Answer();
+	CHECK(strcmp(answer, "ACK") == 0, "first frame: answer \"%s\", expected ACK", answer);
+
+	// complete upload
+	for (pos = first; pos < size; pos += frames[pos + 2] + 5) {
+		answer = SendFrame(&frames[pos], frames[pos + 2] + 5);
+		CHECK(strcmp(answer, "ACK") == 0, "frame at %d: answer \"%s\", expected ACK", (int) pos, answer);
+		if (frames[pos + 1] == UART_CMD_WRITE) {
+			CHECK(UPLOADING, "rendering not stopped during the upload");
+		}
+	}
+	CHECK(pos == size, "frames.bin ends within a frame");
+	CHECK(memcmp(image, messages, image_size) == 0, "EEPROM image differs from the uploaded data");
+	CHECK(CheckDirectory(), "message directory invalid after the upload");
+	CHECK(msg_dir.count == count, "%d messages after the upload, expected %d", msg_dir.count, count);
+	CHECK(!UPLOADING && (msg_num == 0), "first message not shown after the upload");
+	CHECK(!uart_rx.overflow, "receive buffer overflow");
+}
+
+
+/*******************
+ * live text tests *
+ *******************/
+
+#ifdef UART_LIVE
+#define SENDER_LAG	2						// bytes the sender still sends after XOFF (FIFO of a USB serial adapter)
+
+static void TestLive(void)
+{
+	static const char text[] = "Build #1234 passed\nBuild #1235 FAILED\n"
+							   "All tests green, deploying to staging now\n\x04";
+	uint8_t frame[8], mode, stopped, lag, fill, max_fill, xoff, xon;
+	uint16_t pos, i;
+	uint32_t t;
+
+	Start();
+	msg_num = 1;
+	mode = 0x05;
+	i = MakeFrame(frame, UART_CMD_LIVE, &mode, 1);
+	CHECK(strcmp(SendFrame(frame, i), "ACK") == 0, "live text not started");
+	CHECK(LIVE_TEXT, "live text not started (state %d)", upload.state);
+
+	// The sender sends a byte every 10 main loop passes, the display scrolls
+	// by one column every 300 passes, so the receive buffer fills up and XOFF is needed.
+	pos = 0;
+	stopped = 0;
+	lag = 0;
+	max_fill = 0;
+	xoff = 0;
+	xon = 0;
+	for (t = 0; (t < 1000000UL) && LIVE_TEXT; t++) {
+		for (i = 0; i < sim_tx_count; i++) {
+			if (sim_tx[i] == UART_XOFF) { stopped = 1; lag = SENDER_LAG; xoff++; }
+			if (sim_tx[i] == UART_XON)  { stopped = 0; xon++; }
+		}
+		sim_tx_count = 0;
+		if ((t % 10 == 0) && (!stopped || lag) && (pos < sizeof(text) - 1)) {
+			if (stopped) { lag--; }
+			Receive(text[pos++]);
+		}
+		fill = (uart_rx.head - uart_rx.tail) & (UART_RX_SIZE - 1);
+		if (fill > max_fill) { max_fill = fill; }
+		UploadService();
+		if (t % 300 == 0) {
+			dmScroll();
+			for (i = 0; i < DISP_SLOTS; i++) { dmDisplay(); }	// (refresh cycle with the new window)
+		}
+	}
+	for (i = 0; i < sim_tx_count; i++) {
+		if (sim_tx[i] == UART_XON) { xon++; }
+	}
+	CHECK(pos == sizeof(text) - 1, "%d of %d bytes sent", pos, (int) sizeof(text) - 1);
+	CHECK(!LIVE_TEXT, "live text not ended by UART_EOT");
+	CHECK(!uart_rx.flow, "flow control still active after the live text");
+	CHECK(msg_num == 1, "message %d shown after the live text, expected 1", msg_num);
+	CHECK(!uart_rx.overflow, "receive buffer overflow");
+	CHECK(max_fill <= UART_XOFF_LEVEL + SENDER_LAG, "%d bytes buffered, XOFF at %d",
+		  max_fill, UART_XOFF_LEVEL);
+	CHECK(xoff > 0, "no XOFF sent");
+	CHECK(xon == xoff, "%d XOFF, but %d XON", xoff, xon);
+	printf("live text: %d bytes, stopped %d times, at most %d bytes buffered\n", pos, xoff, max_fill);
+}
+#endif
+
+
+int main(int argc, char** argv)
+{
+	if ((argc == 5) && (strcmp(argv[1], "upload") == 0)) {
+		TestUpload(argv[2], argv[3], atoi(argv[4]));
+	}
+	#ifdef UART_LIVE
+	else if ((argc == 2) && (strcmp(argv[1], "live") == 0)) {
+		TestLive();
+	}
+	#endif
+	else {
+		fprintf(stderr, "usage: uart_test upload frames.bin image.bin count | live\n");
+		return (2);
+	}
+	return (failures ? 1 : 0);
+}
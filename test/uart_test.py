@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#
+# uart_test.py
+#
+# Description:	Check the serial message upload (UART_UPLOAD) and the live
+#				text (UART_LIVE) on the host.
+#				The firmware is built together with uart_test.c against the
+#				avr-libc stubs, which stand in for the USART and the EEPROM.
+#				uart_test.c feeds it the frames written by tools/msgupload.py
+#				for upload.txt and corrupted, truncated, oversized and unknown
+#				frames, and checks the ACK/NAK answers, the EEPROM image and
+#				the scheduling of the EEPROM writes.
+#				With UART_LIVE it also streams live text faster than the
+#				display scrolls and checks the XON/XOFF flow control.
+#
+# Usage:		test/uart_test.py
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from hostbuild import ROOT, TEST, TestError, build, make_variant
+
+sys.path.insert(0, os.path.join(ROOT, 'tools'))
+import msgcompile
+
+PLAYLIST = os.path.join(TEST, 'upload.txt')
+
+# firmware configurations (changes of dot_matrix.h, defines of config.h)
+VARIANTS = [
+	('default', {}, ['UART_UPLOAD']),
+	('streaming', {'DISP_STREAMING': '', 'DISP_MAX': '64'}, ['UART_UPLOAD']),
+	('live text', {'DISP_STREAMING': '', 'DISP_MAX': '64'}, ['UART_UPLOAD', 'UART_LIVE']),
+]
+
+
+def run(name, exe, args):
+	result = subprocess.run([exe] + args, capture_output=True, text=True)
+	sys.stdout.write(result.stdout)
+	sys.stderr.write(result.stderr)
+	if result.returncode != 0:
+		raise TestError('%s: %s failed' % (name, ' '.join(args[:1])))
+
+
+def check_variant(name, changes, defines, messages):
+	tmp = tempfile.mkdtemp(prefix='uart_test_')
+	try:
+		make_variant(tmp, changes)
+		exe = build(tmp, 'uart_test', ['uart_test.c', os.path.join(tmp, 'dot_matrix.c'), 'sim.c'],
+					defines)
+		frames = os.path.join(tmp, 'frames.bin')
+		subprocess.run([sys.executable, os.path.join(ROOT, 'tools', 'msgupload.py'),
+						'-o', frames, PLAYLIST], check=True, stdout=subprocess.DEVNULL)
+		image = os.path.join(tmp, 'image.bin')
+		with open(image, 'wb') as f:
+			f.write(msgcompile.message_data(messages))
+		run(name, exe, ['upload', frames, image, str(len(messages))])
+		if 'UART_LIVE' in defines:
+			run(name, exe, ['live'])
+	finally:
+		shutil.rmtree(tmp)
+	print('%s: upload%s OK' % (name, ', live text' if 'UART_LIVE' in defines else ''))
+
+
+def main():
+	target = msgcompile.Target(ROOT)
+	messages = msgcompile.compile_file(target, PLAYLIST)
+	if messages is None:
+		return 1
+	try:
+		for name, changes, defines in VARIANTS:
+			check_variant(name, changes, defines, messages)
+	except (TestError, subprocess.CalledProcessError) as err:
+		sys.stderr.write('uart_test: %s\n' % err)
+		return 1
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main())
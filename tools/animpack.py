@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+#
+# animpack.py
+#
+# Description:	Convert animation headers (animations/*.h) between the raw
+#				frame format and the packed format (delta and repeat frames).
+#				See animations.h for a description of both formats.
+#
+# Usage:		tools/animpack.py [-r] [-n] file.h [file.h ...]
+#				-r	write raw frames only (e. g. for editing)
+#				-n	do not rewrite the files, only print the sizes
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import re
+import sys
+
+COLUMNS = 5				# DISP_COLUMNS
+
+END_OF_DATA = 0xFF
+LOOP_START = 0xFE
+FRAME_TIME = 0x80		# 0x81..0xBF
+DELTA_FRAME = 0xC0		# 0xC0..0xDF
+REPEAT_FRAME = 0xE0		# 0xE1..0xFC
+REPEAT_MAX = 28
+
+TOKEN = re.compile(r'(0x[0-9A-Fa-f]+|\d+|FRAME_TIME\s*\(\s*\w+\s*\)|DELTA_FRAME\s*\(\s*\w+\s*\)|'
+				   r'REPEAT_FRAME\s*\(\s*\w+\s*\)|LOOP_START|END_OF_DATA)')
+ARRAY = re.compile(r'^(?P<head>[^\n]*\bPROGMEM\s*=\s*\{)(?P<body>.*?)^\};', re.S | re.M)
+
+
+def parse(body):
+	"""Return the animation data as a list of byte values."""
+	body = re.sub(r'//[^\n]*', '', body)
+	body = re.sub(r'/\*.*?\*/', '', body, flags=re.S)
+	data = []
+	for tok in TOKEN.findall(body):
+		arg = re.search(r'\(\s*(\w+)\s*\)', tok)
+		if tok.startswith('FRAME_TIME'):
+			data.append(FRAME_TIME | int(arg.group(1), 0))
+		elif tok.startswith('DELTA_FRAME'):
+			data.append(DELTA_FRAME | int(arg.group(1), 0))
+		elif tok.startswith('REPEAT_FRAME'):
+			data.append(REPEAT_FRAME | int(arg.group(1), 0))
+		elif tok == 'LOOP_START':
+			data.append(LOOP_START)
+		elif tok == 'END_OF_DATA':
+			data.append(END_OF_DATA)
+		else:
+			data.append(int(tok, 0))
+	return data
+
+
+def decode(data):
+	"""Decode animation data into a list of (control codes, frame) tuples."""
+	items = []
+	codes = []
+	frame = [0] * COLUMNS
+	i = 0
+	while i < len(data) and data[i] != END_OF_DATA:
+		ch = data[i]
+		if ch < 0x80:								# raw frame
+			if i + COLUMNS > len(data) or any(b >= 0x80 for b in data[i:i + COLUMNS]):
+				raise ValueError('incomplete frame at byte %d' % i)
+			frame = data[i:i + COLUMNS]
+			i += COLUMNS
+		elif ch < DELTA_FRAME or ch == LOOP_START:	# control code
+			codes.append(ch)
+			i += 1
+			continue
+		elif ch < REPEAT_FRAME:						# delta frame
+			frame = list(frame)
+			i += 1
+			for col in range(COLUMNS):
+				if ch & (1 << col):
+					frame[col] = data[i]
+					i += 1
+		else:										# repeat frame
+			for n in range(ch & 0x1F):
+				items.append((codes, list(frame)))
+				codes = []
+			i += 1
+			continue
+		items.append((codes, list(frame)))
+		codes = []
+	return items
+
+
+def hexbytes(values):
+	return ''.join('0x%02X, ' % b for b in values)
+
+
+def line(data, comment):
+	"""Return a source line with the comment aligned to the raw frame lines."""
+	text = '\t' + data
+	width = len(text.expandtabs(4))
+	text += '\t'
+	width = (width // 4 + 1) * 4
+	while width < 36:
+		text += '\t'
+		width += 4
+	return text + '// ' + comment
+
+
+def code_name(ch):
+	if ch == LOOP_START:
+		return 'LOOP_START'
+	return 'FRAME_TIME(%d)' % (ch & 0x3F)
+
+
+def encode(items, packed):
+	"""Encode a list of (control codes, frame) tuples. Return (source lines, size)."""
+	lines = []
+	size = 1										# END_OF_DATA
+	prev = None
+	k = 0
+	while k < len(items):
+		codes, frame = items[k]
+		for ch in codes:
+			lines.append('\t%s,' % code_name(ch))
+			size += 1
+		keyframe = (prev is None) or (LOOP_START in codes) or not packed
+		if keyframe:
+			lines.append(line(hexbytes(frame), 'frame %d' % (k + 1)))
+			size += COLUMNS
+			k += 1
+		elif frame == prev and not codes:
+			n = 1									# run of identical frames
+			while (n < REPEAT_MAX and k + n < len(items)
+				   and items[k + n][1] == prev and not items[k + n][0]):
+				n += 1
+			if n == 1:
+				lines.append(line('REPEAT_FRAME(1),', 'frame %d' % (k + 1)))
+			else:
+				lines.append(line('REPEAT_FRAME(%d),' % n, 'frame %d..%d' % (k + 1, k + n)))
+			size += 1
+			k += n
+		else:
+			mask = 0
+			for col in range(COLUMNS):
+				if frame[col] != prev[col]:
+					mask |= 1 << col
+			changed = [frame[col] for col in range(COLUMNS) if mask & (1 << col)]
+			if len(changed) + 1 < COLUMNS:
+				lines.append(line('DELTA_FRAME(0x%02X), %s' % (mask, hexbytes(changed)), 'frame %d' % (k + 1)))
+				size += 1 + len(changed)
+			else:
+				lines.append(line(hexbytes(frame), 'frame %d' % (k + 1)))
+				size += COLUMNS
+			k += 1
+		prev = frame
+	lines.append('\tEND_OF_DATA')
+	return lines, size
+
+
+def main(argv):
+	packed = True
+	write = True
+	files = []
+	for arg in argv:
+		if arg == '-r':
+			packed = False
+		elif arg == '-n':
+			write = False
+		else:
+			files.append(arg)
+	if not files:
+		sys.stderr.write('usage: animpack.py [-r] [-n] file.h [file.h ...]\n')
+		return 2
+
+	total_old = total_new = 0
+	for name in files:
+		with open(name, newline='') as f:
+			text = f.read()
+		eol = '\r\n' if '\r\n' in text else '\n'
+		match = ARRAY.search(text)
+		if not match:
+			sys.stderr.write('%s: no PROGMEM array found, skipped\n' % name)
+			continue
+		data = parse(match.group('body'))
+		try:
+			items = decode(data)
+		except ValueError as err:
+			sys.stderr.write('%s: %s, skipped\n' % (name, err))
+			continue
+		lines, size = encode(items, packed)
+		print('%-28s %4d frames %5d -> %5d bytes' % (name, len(items), len(data), size))
+		total_old += len(data)
+		total_new += size
+		if write:
+			body = eol + eol.join(lines) + eol
+			text = text[:match.start('body')] + body + text[match.end('body'):]
+			with open(name, 'w', newline='') as f:
+				f.write(text)
+	print('%-28s %18d -> %5d bytes' % ('total', total_old, total_new))
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))
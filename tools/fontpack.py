@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+#
+# fontpack.py
+#
+# Description:	Generate the packed proportional font (Font_5x7_packed.h) from
+#				the font table with fixed 5 byte glyphs (Font_5x7_extended.h).
+#				In the source table a column with bit 7 set ends a narrow glyph.
+#				A glyph is located by the offset of its group (font_offset[])
+#				plus its offset within the group (font_start[]), so printing
+#				a character takes two table reads. Also generates the table
+#				that maps character codes to glyphs.
+#
+# Usage:		tools/fontpack.py [Font_5x7_extended.h [Font_5x7_packed.h]]
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import re
+import sys
+import unicodedata
+
+FIRST = 32				# character code of the first glyph
+WIDTH = 5				# CHAR_WIDTH
+GROUP = 8				# number of glyphs per offset table entry (power of 2, up to 16 for font_start[])
+
+NO_GLYPH = 0xFF
+
+# Latin-1 characters with a glyph of their own in the special character range
+LATIN1 = {
+	0xC4: 133,			# A umlaut
+	0xD6: 135,			# O umlaut
+	0xDC: 137,			# U umlaut
+	0xDF: 138,			# sharp s
+	0xE4: 132,			# a umlaut
+	0xF6: 134,			# o umlaut
+	0xFC: 136,			# u umlaut
+}
+LATIN1_FIRST = 0xC0		# codes below are special characters (see '^' in DisplayMessage())
+
+GLYPH = re.compile(r'^\s*((?:0x[0-9A-Fa-f]{2}\s*,?\s*){%d})(//.*)?$' % WIDTH, re.M)
+
+
+def read_font(name):
+	"""Return a list of (columns, comment) tuples."""
+	with open(name, encoding='utf-8', newline='') as f:
+		text = f.read()
+	glyphs = []
+	for match in GLYPH.finditer(text):
+		data = [int(x, 16) for x in re.findall(r'0x[0-9A-Fa-f]{2}', match.group(1))]
+		columns = []
+		for b in data:
+			if b & 0x80:
+				break
+			columns.append(b)
+		glyphs.append((columns, (match.group(2) or '').rstrip()))
+	return glyphs
+
+
+def char_map(count):
+	"""Return the glyph numbers of the character codes FIRST..255."""
+	result = []
+	for code in range(FIRST, 256):
+		if code in LATIN1:
+			glyph = LATIN1[code] - FIRST
+		elif code < LATIN1_FIRST:
+			glyph = code - FIRST
+		else:								# accented letter -> base letter
+			base = unicodedata.normalize('NFD', chr(code))[0]
+			glyph = ord(base) - FIRST if base.isascii() and base.isalpha() else NO_GLYPH
+		if glyph != NO_GLYPH and glyph >= count:
+			glyph = NO_GLYPH
+		result.append(glyph)
+	return result
+
+
+def write_font(name, glyphs, source):
+	offsets = []
+	starts = []
+	widths = []
+	pos = 0
+	for n, (columns, comment) in enumerate(glyphs):
+		if n % GROUP == 0:
+			offsets.append(pos)
+		starts.append(pos - offsets[-1])
+		widths.append(len(columns))
+		pos += len(columns)
+	if len(widths) % 2:
+		widths.append(0)
+
+	out = []
+	out.append('// Packed proportional 5x7 font')
+	out.append('// Generated by tools/fontpack.py from %s, do not edit.' % source)
+	out.append('')
+	out.append('#define FONT_FIRST\t\t%d\t\t\t// character code of the first glyph' % FIRST)
+	out.append('#define FONT_COUNT\t\t%d\t\t\t// number of glyphs' % len(glyphs))
+	out.append('#define FONT_GROUP\t\t%d\t\t\t// number of glyphs per entry of font_offset[]' % GROUP)
+	out.append('')
+	out.append('// offset of the first glyph of every group of FONT_GROUP glyphs in font_data[]')
+	out.append('const uint16_t font_offset[] PROGMEM = {')
+	for i in range(0, len(offsets), 8):
+		out.append('\t' + ' '.join('%d,' % o for o in offsets[i:i + 8]))
+	out.append('};')
+	out.append('')
+	out.append('// offset of every glyph within its group in font_data[]')
+	out.append('const uint8_t font_start[] PROGMEM = {')
+	for i in range(0, len(starts), 16):
+		out.append('\t' + ' '.join('%d,' % s for s in starts[i:i + 16]))
+	out.append('};')
+	out.append('')
+	out.append('// width of every glyph in columns (4 bits per glyph, low nibble = even glyph number)')
+	out.append('const uint8_t font_width[] PROGMEM = {')
+	nibbles = ['0x%X%X,' % (widths[i + 1], widths[i]) for i in range(0, len(widths), 2)]
+	for i in range(0, len(nibbles), 8):
+		out.append('\t' + ' '.join(nibbles[i:i + 8]))
+	out.append('};')
+	out.append('')
+	out.append('// glyph number of every character code from FONT_FIRST to 255 (0xFF = no glyph)')
+	out.append('// Codes up to 191 select the glyph of the same number (special characters above 127),')
+	out.append('// Latin-1 letters from 192 are mapped to the umlaut glyphs or to their base letter.')
+	out.append('const uint8_t font_map[] PROGMEM = {')
+	cmap = char_map(len(glyphs))
+	for i in range(0, len(cmap), 16):
+		out.append('\t' + ' '.join('0x%02X,' % g for g in cmap[i:i + 16]) + '\t// code %d' % (FIRST + i))
+	out.append('};')
+	out.append('')
+	out.append('// glyph columns')
+	out.append('const uint8_t font_data[] PROGMEM = {')
+	for columns, comment in glyphs:
+		text = '\t' + ''.join('0x%02X, ' % b for b in columns)
+		width = len(text.expandtabs(4))
+		text += '\t'
+		width = (width // 4 + 1) * 4
+		while width < 36:
+			text += '\t'
+			width += 4
+		out.append(text + comment)
+	out.append('};')
+
+	with open(name, 'w', encoding='utf-8', newline='') as f:
+		f.write('\n'.join(out) + '\n')
+
+	size = 2 * len(offsets) + len(starts) + len(widths) // 2 + pos
+	print('%s: %d glyphs, %d bytes (fixed width table: %d bytes), character map %d bytes'
+		  % (name, len(glyphs), size, WIDTH * len(glyphs), len(cmap)))
+
+
+def main(argv):
+	source = argv[0] if len(argv) > 0 else 'Font_5x7_extended.h'
+	target = argv[1] if len(argv) > 1 else 'Font_5x7_packed.h'
+	glyphs = read_font(source)
+	if not glyphs:
+		sys.stderr.write('%s: no glyphs found\n' % source)
+		return 1
+	write_font(target, glyphs, source)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))
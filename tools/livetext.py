@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+#
+# livetext.py
+#
+# Description:	Stream text from standard input to the display via the serial
+#				port (firmware built with UART_LIVE, see config.h), e. g. as a
+#				ticker for build results:  make 2>&1 | tools/livetext.py /dev/ttyUSB0
+#				Every line is followed by a long space. The display stops the
+#				sender by XOFF as long as it has no room for more characters.
+#				At the end of the input the display returns to its messages.
+#
+# Usage:		tools/livetext.py [-b baud] port [options]
+#				(options as in messages.txt, e. g. speed=12.5, default speed=8.3)
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import msgcompile
+import msgupload
+
+CMD_LIVE = ord('L')		# UART_CMD_LIVE
+EOT = 0x04				# UART_EOT
+
+
+def main(argv):
+	baud = None
+	if len(argv) >= 2 and argv[0] == '-b':
+		baud = int(argv[1])
+		argv = argv[2:]
+	if not argv:
+		sys.stderr.write('usage: livetext.py [-b baud] port [options]\n')
+		return 2
+	port = argv[0]
+	options = ' '.join(argv[1:]) or 'speed=8.3'
+
+	target = msgcompile.Target(msgupload.ROOT)
+	config = msgcompile.read(os.path.join(msgupload.ROOT, 'config.h'))
+	if baud is None:
+		baud = msgcompile.define(config, 'UART_BAUD')
+	try:
+		msg = msgcompile.compile_line(target, 0, options + ' ""')
+	except msgcompile.PlaylistError as err:
+		sys.stderr.write('%s\n' % err)
+		return 1
+
+	import serial
+	with serial.serial_for_url(port, baud, timeout=msgupload.TIMEOUT) as ser:
+		if not msgupload.send(ser, msgupload.frame(CMD_LIVE, bytes((msg.mode,)))):
+			sys.stderr.write('%s: no live text mode\n' % port)
+			return 1
+		ser.xonxoff = True
+		try:
+			for line in sys.stdin:
+				text = line.rstrip('\r\n').replace('\t', ' ')
+				ser.write(text.encode('latin-1', errors='replace') + b'\n')
+		except KeyboardInterrupt:
+			pass
+		ser.write(bytes((EOT,)))
+		ser.flush()
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,455 @@
+#!/usr/bin/env python3
+#
+# msgcompile.py
+#
+# Description:	Compile the message playlist (messages.txt) into the default
+#				message data and message directory in EEPROM (messages.h).
+#				The escapes of the playlist are checked, and for every message
+#				the rendered width (compared to DISP_MAX) and the duration of
+#				one scrolling or animation cycle are reported.
+#				The playlist format is described in messages.txt.
+#
+# Usage:		tools/msgcompile.py [-n] [messages.txt [messages.h]]
+#				-n	do not write the output file, only print the report
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import math
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import animpack
+
+COLUMNS = animpack.COLUMNS	# DISP_COLUMNS
+
+LONG_SPACE = 0x9D
+SHORT_SPACE = 0x7F
+DIRECT = 0xFF
+SPECIAL_SHIFT = 63			# '^' + character (see RenderMessage() in main.c)
+
+MODE_BIDIRECTIONAL = 0x80
+MODE_INC5 = 0x08
+
+
+class PlaylistError(Exception):
+	pass
+
+
+def read(name):
+	with open(name, encoding='utf-8', errors='replace') as f:
+		return f.read()
+
+
+def define(text, name, default=None):
+	"""Return the value of an active #define (True if it has no value)."""
+	match = re.search(r'^[ \t]*#define[ \t]+%s\b[ \t]*([^\s/]*)' % name, text, re.M)
+	if not match:
+		return default
+	return int(match.group(1), 0) if match.group(1) else True
+
+
+def table(text, name):
+	match = re.search(r'\b%s\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}' % name, text)
+	if not match:
+		raise PlaylistError('table %s not found' % name)
+	body = re.sub(r'//[^\n]*', '', match.group(1))
+	return [int(x, 0) for x in re.findall(r'0x[0-9A-Fa-f]+|\d+', body)]
+
+
+class Target:
+	"""Firmware settings and data that the playlist is compiled for."""
+
+	def __init__(self, root):
+		config = read(os.path.join(root, 'config.h'))
+		display = read(os.path.join(root, 'dot_matrix.h'))
+		font = read(os.path.join(root, 'Font_5x7_packed.h'))
+
+		self.msg_size = define(config, 'MSG_SIZE')
+		self.msg_max = define(config, 'MSG_MAX')
+		self.tick = 1.0 / define(config, 'SYS_TIMER_FREQ')
+		self.utf8 = bool(define(config, 'MSG_UTF8'))
+		self.dly_conv = table(config, 'dly_conv')
+		self.spd_conv = table(config, 'spd_conv')
+
+		self.disp_max = define(display, 'DISP_MAX')
+		self.streaming = bool(define(display, 'DISP_STREAMING'))
+		self.marquee_gap = define(display, 'DISP_MARQUEE_GAP', 0) if define(display, 'DISP_MARQUEE') else None
+
+		self.font_first = define(font, 'FONT_FIRST')
+		widths = table(font, 'font_width')
+		self.font_width = [n for b in widths for n in (b & 0x0F, b >> 4)]
+		self.font_map = table(font, 'font_map')
+
+		# animations in the order of animation[] (animations.h)
+		header = read(os.path.join(root, 'animations.h'))
+		data = {}
+		for inc in re.findall(r'^\s*#include\s+"([^"]+)"', header, re.M):
+			match = animpack.ARRAY.search(read(os.path.join(root, inc)))
+			if match:
+				name = re.search(r'(\w+)\s*\[\]', match.group('head')).group(1)
+				data[name] = animpack.parse(match.group('body'))
+		match = re.search(r'\banimation\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}', header)
+		self.animations = re.findall(r'\w+', match.group(1))
+		self.anim_data = data
+
+	def width(self, code):
+		"""Width of a character in columns (0 if there is no glyph)."""
+		if code < self.font_first:
+			return 0
+		glyph = self.font_map[code - self.font_first]
+		return self.font_width[glyph] if glyph < len(self.font_width) else 0
+
+	def has_glyph(self, code):
+		return code >= self.font_first and self.font_map[code - self.font_first] < len(self.font_width)
+
+	def animation(self, name):
+		"""Return (index, decoded frames) of an animation."""
+		if name not in self.animations:
+			raise PlaylistError('unknown animation "%s" (available: %s)' % (name, ', '.join(self.animations)))
+		index = self.animations.index(name)
+		if index >= 26:
+			raise PlaylistError('animation "%s" cannot be addressed by a letter' % name)
+		data = self.anim_data.get(name)
+		if data is None:
+			raise PlaylistError('data of animation "%s" not found' % name)
+		try:
+			frames = animpack.decode(data)
+		except ValueError as err:
+			raise PlaylistError('animation "%s": %s' % (name, err))
+		return index, frames
+
+
+def nearest(values, wanted):
+	"""Index of the value that is closest to wanted (on a logarithmic scale)."""
+	return min(range(len(values)), key=lambda i: abs(math.log(values[i] / wanted)))
+
+
+class Message:
+	def __init__(self, line):
+		self.line = line
+		self.mode = 0
+		self.data = bytearray()
+		self.columns = 0		# rendered width
+		self.player = None		# (name, frames) if played by the animation player
+		self.label = ''
+		self.warnings = []
+
+
+def parse_options(msg, target, options):
+	speed = None
+	pause = 0
+	inc = 1
+	for opt in options.split():
+		key, _, value = opt.partition('=')
+		try:
+			if key == 'speed' and value:
+				speed = float(value)
+				if speed <= 0:
+					raise ValueError
+			elif key == 'pause' and value:
+				pause = int(value, 0)
+			elif key == 'step' and value in ('1', '5'):
+				inc = int(value)
+			elif key == 'bounce' and not value:
+				msg.mode |= MODE_BIDIRECTIONAL
+			else:
+				raise ValueError
+		except ValueError:
+			raise PlaylistError('invalid option "%s"' % opt)
+	if speed is None:
+		raise PlaylistError('option speed=... missing')
+	return speed, pause, inc
+
+
+def encode_char(msg, target, code):
+	"""Return the message bytes of a character code."""
+	if code == ord('^'):
+		return b'^^'
+	if code == ord('~'):							# '~' starts an animation escape
+		return bytes((ord('^'), code - SPECIAL_SHIFT))
+	if target.utf8 and code >= 0xC0:
+		return chr(code).encode('utf-8')
+	return bytes((code,))
+
+
+def parse_text(msg, target, text):
+	"""Compile the message text. Return a list of (bytes, columns) items."""
+	items = []
+	i = 0
+	while i < len(text):
+		ch = text[i]
+		i += 1
+		if ch == '{' and text.startswith('{', i):
+			ch = '{'
+			i += 1
+		elif ch == '{':
+			end = text.find('}', i)
+			if end < 0:
+				raise PlaylistError('missing "}"')
+			esc = text[i:end]
+			i = end + 1
+			items.append(parse_escape(msg, target, esc, len(text) == end + 1 and len(items) == 0))
+			continue
+		code = ord(ch)
+		if code == 0xA0:							# no-break space
+			code = 0x20
+		if code < 0x20 or code == 0x7F:
+			raise PlaylistError('control character U+%04X in text' % code)
+		if 0x80 <= code < 0xC0:
+			raise PlaylistError('"%s" cannot be displayed (special characters are entered as {^X} or {0xNN})' % ch)
+		if code == DIRECT and not target.utf8:
+			raise PlaylistError('"%s" (0xFF) is the direct mode code' % ch)
+		if code > 0xFF:
+			if not target.utf8:
+				raise PlaylistError('"%s" is not a Latin-1 character' % ch)
+			msg.warnings.append('"%s" is shown as "?"' % ch)
+			items.append((ch.encode('utf-8'), target.width(ord('?'))))
+			continue
+		if not target.has_glyph(code):
+			msg.warnings.append('no glyph for "%s"' % ch)
+		items.append((encode_char(msg, target, code), target.width(code)))
+	return items
+
+
+def parse_escape(msg, target, esc, alone):
+	key, colon, arg = esc.partition(':')
+	if esc == 'long':
+		return bytes((LONG_SPACE,)), target.width(LONG_SPACE)
+	if esc == 'short':
+		return bytes((SHORT_SPACE,)), target.width(SHORT_SPACE)
+	if len(esc) == 2 and esc[0] == '^':				# special character
+		code = ord(esc[1]) + SPECIAL_SHIFT
+		if esc[1] == '^' or ord(esc[1]) < 0x21 or code > 0xFE:
+			raise PlaylistError('invalid special character {%s}' % esc)
+		return esc.encode('ascii'), target.width(code)
+	if re.fullmatch(r'0x[0-9A-Fa-f]{1,2}|\d{1,3}', esc):	# character code
+		code = int(esc, 0)
+		if code < 0x20 or code >= DIRECT:
+			raise PlaylistError('invalid character code {%s}' % esc)
+		if not target.has_glyph(code):
+			msg.warnings.append('no glyph for character code %s' % esc)
+		return encode_char(msg, target, code), target.width(code)
+	if colon and key == 'anim':						# animation rendered into the display memory
+		index, frames = target.animation(arg)
+		return bytes((ord('~'), ord('A') + index)), COLUMNS * len(frames)
+	if colon and key == 'play':						# animation player
+		index, frames = target.animation(arg)
+		if not alone:
+			raise PlaylistError('{play:%s} must be the only content of the message' % arg)
+		msg.player = (arg, frames)
+		return bytes((ord('~'), ord('a') + index)), 0
+	if colon and key == 'raw':						# direct mode
+		try:
+			values = [int(x, 0) for x in arg.replace(',', ' ').split()]
+		except ValueError:
+			values = []
+		if not values or any(v < 0 or v > 0x7F for v in values):
+			raise PlaylistError('{raw:...} needs column values 0x00..0x7F')
+		return bytes([DIRECT] + values + [DIRECT]), len(values)
+	raise PlaylistError('unknown escape {%s}' % esc)
+
+
+def compile_line(target, number, line):
+	"""Compile a playlist line into a message (None for empty and comment lines)."""
+	stripped = line.strip()
+	if not stripped or stripped.startswith('#'):
+		return None
+	first = line.find('"')
+	last = line.rfind('"')
+	if first < 0 or last == first:
+		raise PlaylistError('message text "..." missing')
+	msg = Message(number)
+	rest = line[last + 1:].strip()
+	if rest and not rest.startswith('#'):
+		raise PlaylistError('unexpected "%s" after the message text' % rest)
+	msg.label = rest[1:].strip()
+	speed, pause, inc = parse_options(msg, target, line[:first])
+
+	items = parse_text(msg, target, line[first + 1:last])
+	if msg.player:
+		inc = 5										# (frame by frame)
+	for data, columns in items:
+		msg.data += data
+	msg.columns = sum(c for d, c in items) + max(len(items) - 1, 0)	# narrow space between the items
+	if not msg.label:								# text without the escapes
+		label = re.sub(r'\{(?:anim|play):(\w+)\}', r' \1 ', line[first + 1:last])
+		label = re.sub(r'\{[^{}]*\}', ' ', label.replace('{{', '{'))
+		msg.label = ' '.join(label.split())
+
+	# mode byte (see SetMode() in main.c)
+	scale = 1 if msg.player else inc				# columns or frames per step
+	rates = [scale / ((s + 1) * target.tick) for s in target.spd_conv]
+	spd = nearest(rates, speed)
+	dly = min(range(len(target.dly_conv)), key=lambda i: abs(target.dly_conv[i] - pause))
+	if target.dly_conv[dly] != pause:
+		msg.warnings.append('pause=%d rounded to %d' % (pause, target.dly_conv[dly]))
+	msg.mode |= (dly << 4) | spd | (MODE_INC5 if inc == 5 else 0)
+	if msg.mode == 0:
+		raise PlaylistError('mode byte 0 would end the message list (choose another speed or pause)')
+	msg.inc = inc
+	msg.step_time = (target.spd_conv[spd] + 1) * target.tick
+	msg.pause = target.dly_conv[dly]
+
+	if not msg.player and msg.columns > target.disp_max and not target.streaming:
+		msg.warnings.append('%d columns wide, only DISP_MAX = %d are shown' % (msg.columns, target.disp_max))
+	if target.streaming and (msg.mode & MODE_BIDIRECTIONAL) and not msg.player:
+		msg.warnings.append('DISP_STREAMING scrolls forward only')
+	return msg
+
+
+def cycle_time(target, msg):
+	"""Duration of one scrolling or animation cycle in seconds (None = static)."""
+	if msg.player:
+		frames = msg.player[1]
+		loop = 0
+		for n, (codes, frame) in enumerate(frames):
+			if animpack.LOOP_START in codes:
+				loop = n
+		steps = 0
+		for codes, frame in frames[loop:]:
+			times = [c & 0x3F for c in codes if c & 0xC0 == animpack.FRAME_TIME and c & 0x3F]
+			steps += times[-1] if times else 1
+		steps += msg.pause
+		if msg.mode & MODE_BIDIRECTIONAL:
+			steps *= 2
+		return steps * msg.step_time
+	if target.marquee_gap is not None:
+		if msg.columns < COLUMNS:
+			return None
+		period = msg.columns + (target.marquee_gap if msg.inc == 1 else 0)
+		return (math.ceil(period / msg.inc) + msg.pause) * msg.step_time
+	if msg.columns <= COLUMNS:
+		return None
+	steps = (msg.columns - COLUMNS) // msg.inc + msg.pause + 1
+	if (msg.mode & MODE_BIDIRECTIONAL) and not target.streaming:
+		steps *= 2
+	return steps * msg.step_time
+
+
+def c_bytes(data):
+	out = []
+	for b in data:
+		if 0x20 <= b < 0x7F and chr(b) not in '\'\\':
+			out.append("'%c'" % b)
+		else:
+			out.append('0x%02X' % b)
+	return ', '.join(out)
+
+
+def compile_file(target, source):
+	"""Compile a playlist. Return the list of messages (None if there are errors)."""
+	messages = []
+	errors = 0
+	with open(source, encoding='utf-8') as f:
+		for number, line in enumerate(f, 1):
+			try:
+				msg = compile_line(target, number, line.rstrip('\r\n'))
+			except PlaylistError as err:
+				sys.stderr.write('%s:%d: error: %s\n' % (source, number, err))
+				errors += 1
+				continue
+			if msg:
+				for text in msg.warnings:
+					sys.stderr.write('%s:%d: warning: %s\n' % (source, number, text))
+				messages.append(msg)
+
+	size = message_offsets(messages)[-1] + 1
+	if len(messages) > target.msg_max:
+		sys.stderr.write('%s: error: %d messages, MSG_MAX = %d\n' % (source, len(messages), target.msg_max))
+		errors += 1
+	if size > target.msg_size:
+		sys.stderr.write('%s: error: %d bytes, MSG_SIZE = %d\n' % (source, size, target.msg_size))
+		errors += 1
+	return None if errors else messages
+
+
+def message_offsets(messages):
+	"""Offsets of the messages and of the end of the list in messages[]."""
+	offsets = []
+	pos = 0
+	for msg in messages:
+		offsets.append(pos)
+		pos += 1 + len(msg.data) + 1				# mode byte, data, terminating 0
+	offsets.append(pos)
+	return offsets
+
+
+def message_data(messages):
+	"""Contents of messages[] (without the unused rest)."""
+	data = bytearray()
+	for msg in messages:
+		data += bytes((msg.mode,)) + msg.data + b'\0'
+	return data + b'\0'
+
+
+def write_header(name, source, messages, offsets, check):
+	out = []
+	out.append('// Default message data and message directory')
+	out.append('// Generated by tools/msgcompile.py from %s, do not edit.' % source)
+	out.append('')
+	out.append('const uint8_t messages[MSG_SIZE] EEMEM = {')
+	for msg in messages:
+		line = '\t0x%02X, %s,' % (msg.mode, c_bytes(msg.data + b'\0'))
+		out.append(line + '\t// ' + msg.label if msg.label else line)
+	out.append('\t0x00')
+	out.append('};')
+	out.append('')
+	out.append('msg_dir_t msg_dir EEMEM = {')
+	out.append('\t%d,' % len(messages))
+	out.append('\t{')
+	for i in range(0, len(offsets), 16):
+		out.append('\t\t' + ' '.join('%d,' % o for o in offsets[i:i + 16]))
+	out.append('\t},')
+	out.append('\t0x%02X' % check)
+	out.append('};')
+	with open(name, 'w', encoding='utf-8', newline='') as f:
+		f.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+	write = True
+	files = []
+	for arg in argv:
+		if arg == '-n':
+			write = False
+		else:
+			files.append(arg)
+	source = files[0] if len(files) > 0 else 'messages.txt'
+	output = files[1] if len(files) > 1 else 'messages.h'
+
+	root = os.path.dirname(os.path.abspath(output))
+	try:
+		target = Target(root)
+	except (OSError, PlaylistError, TypeError) as err:
+		sys.stderr.write('%s: cannot read the firmware configuration: %s\n' % (output, err))
+		return 1
+	messages = compile_file(target, source)
+	if messages is None:
+		return 1
+	offsets = message_offsets(messages)
+	pos = offsets[-1]
+
+	limit = 'streaming' if target.streaming else 'of %d' % target.disp_max
+	print(' #  mode  bytes  width %-10s  cycle    message' % ('(' + limit + ')'))
+	for n, msg in enumerate(messages):
+		if msg.player:
+			width = '%d frames' % len(msg.player[1])
+		else:
+			width = '%d columns' % msg.columns
+		time = cycle_time(target, msg)
+		time = '%6.2f s' % time if time is not None else '  static'
+		print('%2d  0x%02X  %5d  %-18s %s  %s' % (n, msg.mode, len(msg.data) + 2, width, time, msg.label))
+	print('%d messages, %d of %d bytes' % (len(messages), pos + 1, target.msg_size))
+
+	if write:
+		check = -(len(messages) + sum(offsets)) & 0xFF
+		write_header(output, source, messages, offsets, check)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# msgupload.py
+#
+# Description:	Compile the message playlist (see tools/msgcompile.py) and upload
+#				it via the serial port into the EEPROM of a running display
+#				(firmware built with UART_UPLOAD, see config.h for the protocol).
+#				Every frame is sent again if it is not acknowledged.
+#				Instead of a serial port the frames may be written to a file,
+#				e. g. to feed a simulated UART.
+#
+# Usage:		tools/msgupload.py [-b baud] port [messages.txt]
+#				tools/msgupload.py -o frames.bin [messages.txt]
+#				(port may be any pyserial URL, e. g. socket://localhost:7777)
+#
+# License:		This software is distributed under the creative commons license
+#				CC-BY-NC-SA.
+#
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import msgcompile
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+
+SYNC = 0x7E				# UART_SYNC
+CMD_WRITE = ord('W')	# UART_CMD_WRITE
+CMD_DONE = ord('D')		# UART_CMD_DONE
+ACK = 0x06				# UART_ACK
+NAK = 0x15				# UART_NAK
+
+RETRIES = 5
+TIMEOUT = 0.5			# [s] (a frame of 16 bytes takes up to 55 ms to be written)
+
+
+def crc_ccitt_update(crc, data):
+	"""Same as _crc_ccitt_update() of avr-libc."""
+	data ^= crc & 0xFF
+	data ^= (data << 4) & 0xFF
+	return ((data << 8) | (crc >> 8)) ^ (data >> 4) ^ (data << 3)
+
+
+def frame(cmd, data=b''):
+	body = bytes((cmd, len(data))) + bytes(data)
+	crc = 0xFFFF
+	for b in body:
+		crc = crc_ccitt_update(crc, b)
+	return bytes((SYNC,)) + body + bytes((crc & 0xFF, crc >> 8))
+
+
+def frames(image, block):
+	"""Frames that write the message data and rebuild the directory."""
+	result = []
+	for ofs in range(0, len(image), block):
+		result.append(frame(CMD_WRITE, bytes((ofs,)) + image[ofs:ofs + block]))
+	result.append(frame(CMD_DONE))
+	return result
+
+
+def send(port, data):
+	"""Send a frame until it is acknowledged. Return True on success."""
+	for attempt in range(RETRIES):
+		port.reset_input_buffer()
+		port.write(data)
+		answer = port.read(1)
+		if answer == bytes((ACK,)):
+			return True
+		if answer == bytes((NAK,)):
+			sys.stderr.write('frame rejected, retrying\n')
+		else:
+			sys.stderr.write('no answer, retrying\n')
+	return False
+
+
+def main(argv):
+	baud = None
+	output = None
+	args = []
+	i = 0
+	while i < len(argv):
+		if argv[i] in ('-b', '-o') and i + 1 < len(argv):
+			if argv[i] == '-b':
+				baud = int(argv[i + 1])
+			else:
+				output = argv[i + 1]
+			i += 2
+		else:
+			args.append(argv[i])
+			i += 1
+	if output is None and not args:
+		sys.stderr.write('usage: msgupload.py [-b baud] port [messages.txt]\n'
+						 '       msgupload.py -o frames.bin [messages.txt]\n')
+		return 2
+	port = args.pop(0) if output is None else None
+	source = args[0] if args else os.path.join(ROOT, 'messages.txt')
+
+	target = msgcompile.Target(ROOT)
+	config = msgcompile.read(os.path.join(ROOT, 'config.h'))
+	block = msgcompile.define(config, 'UART_BLOCK_SIZE')
+	if baud is None:
+		baud = msgcompile.define(config, 'UART_BAUD')
+	messages = msgcompile.compile_file(target, source)
+	if messages is None:
+		return 1
+	image = msgcompile.message_data(messages)
+	data = frames(image, block)
+	print('%d messages, %d bytes, %d frames' % (len(messages), len(image), len(data)))
+
+	if output:
+		with open(output, 'wb') as f:
+			f.write(b''.join(data))
+		return 0
+
+	import serial
+	with serial.serial_for_url(port, baud, timeout=TIMEOUT) as ser:
+		for n, packet in enumerate(data):
+			if not send(ser, packet):
+				sys.stderr.write('%s: upload failed at frame %d\n' % (port, n))
+				return 1
+	print('done')
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1:]))